@@ -0,0 +1,243 @@
+// Copyright (c) 2021 Sapphire's Suite. All Rights Reserved.
+
+#include <UnitTestHelper.hpp>
+using namespace Sa;
+
+#include <algorithm>
+#include <unordered_map>
+
+using namespace std::chrono_literals;
+
+/// Methods with benchmarks (can be in a separated file).
+void RangeBenchs()
+{
+	const std::vector<size_t> sizes = { 256, 1024, 4096, 16384 };
+
+	// Simple body: only use input size.
+	SA_UTH_BENCH_RANGE(Accumulate, sizes, [](size_t _n)
+	{
+		size_t sum = 0u;
+
+		for (size_t i = 0u; i < _n; ++i)
+		{
+			sum += i;
+
+			// Prevent the compiler from folding the loop.
+			UTH::DoNotOptimize(sum);
+		}
+	});
+
+
+	// Returned values are kept alive by the benchmark.
+	SA_UTH_BENCH_RANGE(Sqrt, sizes, [](UTH::BenchState& _state)
+	{
+		_state.items = 1u;
+
+		// Input is considered modified: sqrt can't be hoisted out of the loop.
+		UTH::DoNotOptimize(_state.n);
+
+		return std::sqrt(static_cast<double>(_state.n));
+	});
+
+
+	// Body with state: report bytes processed and declare expected complexity.
+	std::vector<int> data;
+
+	SA_UTH_BENCH_RANGE(Sort, sizes, [&data](UTH::BenchState& _state)
+	{
+		data.resize(_state.n);
+
+		for (size_t i = 0u; i < _state.n; ++i)
+			data[i] = static_cast<int>((_state.n - i) * 2654435761u);
+
+		std::sort(data.begin(), data.end());
+
+		_state.bytes = _state.n * sizeof(int);
+	}, UTH::Complexity::ON2);
+}
+
+/// Benchmarks with environment controls.
+void EnvBenchs()
+{
+	const std::vector<size_t> sizes = { 1024, 16384 };
+	std::vector<float> data(16384, 1e-39f); // Denormals.
+
+	// Pin thread to first CPU, flush denormals and try to raise priority.
+	UTH::benchSettings.env.cpu = 0;
+	UTH::benchSettings.env.bFlushDenormals = true;
+	UTH::benchSettings.env.bHighPriority = true;
+
+	SA_UTH_BENCH_RANGE(DenormalsWarm, sizes, [&data](size_t _n)
+	{
+		float sum = 0.0f;
+
+		for (size_t i = 0u; i < _n; ++i)
+			sum += data[i] * 0.5f;
+
+		return sum;
+	});
+
+
+	// Same body with cold cache.
+	UTH::benchSettings.env.bColdCache = true;
+
+	SA_UTH_BENCH_RANGE(DenormalsCold, sizes, [&data](size_t _n)
+	{
+		float sum = 0.0f;
+
+		for (size_t i = 0u; i < _n; ++i)
+			sum += data[i] * 0.5f;
+
+		return sum;
+	});
+
+
+	// Reset to default.
+	UTH::benchSettings.env = UTH::BenchEnv{};
+}
+
+/// Benchmarks sampled until their median converges.
+void AdaptiveBenchs()
+{
+	const std::vector<size_t> sizes = { 1024, 4096, 16384 };
+
+	// Sample until the median is known within +/- 0.5% or 0.5s is spent per size.
+	UTH::benchSettings.bAdaptive = true;
+	UTH::benchSettings.targetCI = 0.005;
+	UTH::benchSettings.maxTime = 0.5;
+
+	SA_UTH_BENCH_RANGE(Accumulate, sizes, [](size_t _n)
+	{
+		size_t sum = 0u;
+
+		for (size_t i = 0u; i < _n; ++i)
+		{
+			sum += i;
+			UTH::DoNotOptimize(sum);
+		}
+	}, UTH::Complexity::ON);
+
+
+	// Reset to default.
+	UTH::benchSettings = UTH::BenchSettings{};
+}
+
+/// Comparison of two implementations.
+void CompareBenchs()
+{
+	std::vector<int> data(4096);
+
+	for (size_t i = 0u; i < data.size(); ++i)
+		data[i] = static_cast<int>(i * 3u);
+
+	int key = 3 * 3000;
+
+	// Linear search.
+	auto baseline = [&data, &key]()
+	{
+		UTH::DoNotOptimize(key);
+
+		return std::find(data.begin(), data.end(), key) != data.end();
+	};
+
+	// Binary search on sorted data.
+	auto candidate = [&data, &key]()
+	{
+		UTH::DoNotOptimize(key);
+
+		return std::binary_search(data.begin(), data.end(), key);
+	};
+
+	// Candidate must be at least 20% faster.
+	SA_UTH_BENCH_COMPARE(Search, baseline, candidate, 0.2);
+}
+
+/// Multi-thread scaling benchmarks.
+void ScalingBenchs()
+{
+	const unsigned int maxThreads = std::thread::hardware_concurrency() ? std::thread::hardware_concurrency() : 1u;
+
+	// Independent work per thread: should scale.
+	auto local = [](UTH::BenchState& _state)
+	{
+		size_t sum = _state.thread;
+
+		for (size_t i = 0u; i < 1024u; ++i)
+		{
+			sum += i;
+			UTH::DoNotOptimize(sum);
+		}
+	};
+
+	SA_UTH_BENCH_SCALING(LocalSum, maxThreads, local, maxThreads > 1u ? 1.2 : 0.0);
+
+
+	// Every thread hits the same atomic: contention.
+	std::atomic<size_t> shared{ 0u };
+
+	auto contended = [&shared]()
+	{
+		for (size_t i = 0u; i < 64u; ++i)
+			shared.fetch_add(1u);
+	};
+
+	SA_UTH_BENCH_SCALING(SharedAtomic, maxThreads, contended);
+}
+
+/// Latency recordings with percentile assertions.
+void LatencyBenchs()
+{
+	std::unordered_map<size_t, size_t> map;
+
+	// Rehashes create latency spikes.
+	auto insert = [&map](size_t _index)
+	{
+		map[_index * 2654435761u] = _index;
+	};
+
+	SA_UTH_LATENCY(MapInsert, insert, 100000, UTH::P50 < 10us, UTH::P(99.99) < 50ms);
+
+
+	// Histograms recorded on several threads can be merged.
+	UTH::Histogram merged;
+
+	for (unsigned int t = 0u; t < 2u; ++t)
+	{
+		UTH::Histogram local;
+
+		std::thread worker([&local]()
+		{
+			for (uint64_t i = 0u; i < 1000u; ++i)
+				local.Record(i * 10u);
+		});
+
+		worker.join();
+
+		merged += local;
+	}
+
+	SA_UTH_EQ(merged.Count(), uint64_t(2000u));
+	SA_UTH_OP(merged.Percentile(50.0), <, uint64_t(5100u));
+}
+
+int main()
+{
+	SA_UTH_INIT();
+
+	// Timeline of groups and benchs in Logs/trace_UTH-*.json (open in ui.perfetto.dev).
+	UTH::bTrace = true;
+
+	// Sampled hot functions per group in Logs/profile_UTH-*.folded (flamegraph.pl, speedscope).
+	UTH::Profiler::Start();
+
+
+	SA_UTH_GP(RangeBenchs());
+	SA_UTH_GP(EnvBenchs());
+	SA_UTH_GP(AdaptiveBenchs());
+	SA_UTH_GP(CompareBenchs());
+	SA_UTH_GP(ScalingBenchs());
+	SA_UTH_GP(LatencyBenchs());
+
+
+	SA_UTH_EXIT();
+}
@@ -30,6 +30,13 @@ void ParamsCB(const std::vector<UTH::Param>& _params)
 		LOG(it->name << ": [" << it->value << "]\n");
 }
 
+void ParamViewsCB(const std::vector<UTH::ParamView>& _params)
+{
+	// Values are only converted to string on ToString() call.
+	for (auto it = _params.begin(); it != _params.end(); ++it)
+		LOG("Param view: " << it->name << " (" << it->TypeName() << "): [" << it->ToString() << "]\n");
+}
+
 void ResultCB(bool _predicate)
 {
 	if (_predicate)
@@ -38,6 +45,43 @@ void ResultCB(bool _predicate)
 		LOG("Result: Failure\n")
 }
 
+void ResultBatchCB(const UTH::ResultRecord* _records, size_t _count)
+{
+	for (size_t i = 0u; i < _count; ++i)
+	{
+		const UTH::TestSite& site = *_records[i].site;
+
+		LOG("Batch result: " << _records[i].pred << " at " << site.FileName() << ':' << site.lineNum <<
+			" thread: " << _records[i].thread << " time: " << _records[i].timestamp << "ns");
+	}
+}
+
+/// Listener with its own state: count results.
+class CountListener : public UTH::Listener
+{
+public:
+	unsigned int success = 0u;
+	unsigned int failure = 0u;
+
+	void OnResult(bool _pred) override
+	{
+		_pred ? ++success : ++failure;
+	}
+};
+
+/// Listener with its own state: collect failed tests location.
+class FailureListener : public UTH::Listener
+{
+public:
+	std::vector<std::string> failures;
+
+	void OnTitle(const UTH::Title& _infos) override
+	{
+		if (!_infos.pred)
+			failures.push_back(_infos.fileName + ':' + std::to_string(_infos.lineNum));
+	}
+};
+
 /// Methods with all the tests (can be in a separated file).
 void MainTests()
 {
@@ -65,10 +109,29 @@ int main()
 	UTH::GroupEndCB = GroupEndCB;
 	UTH::TitleCB = TitleCB;
 	UTH::ParamsCB = ParamsCB;
+	UTH::ParamViewsCB = ParamViewsCB;
 	UTH::ResultCB = ResultCB;
 
+	// Compact results sent in batches (every resultBatchSize results and on group end).
+	UTH::ResultBatchCB = ResultBatchCB;
+
+	// Listeners: multiple subscribers, each with its own state and event mask.
+	CountListener countListener;
+	UTH::AddListener(countListener, UTH::Event::Result);
+
+	FailureListener failureListener;
+	UTH::AddListener(failureListener, UTH::Event::Title);
+
 	SA_UTH_GP(MainTests());
 
+	UTH::RemoveListener(failureListener);
+	UTH::RemoveListener(countListener);
+
+	LOG("Listener: " << countListener.success << " success, " << countListener.failure << " failure");
+
+	for (auto it = failureListener.failures.begin(); it != failureListener.failures.end(); ++it)
+		LOG("Listener: failure at " << *it);
+
 
 	SA_UTH_EXIT();
 }
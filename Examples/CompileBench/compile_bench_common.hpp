@@ -0,0 +1,36 @@
+// Copyright (c) 2021 Sapphire's Suite. All Rights Reserved.. All Rights Reserved.
+
+#pragma once
+
+#include <ostream>
+
+/// Tested functions of the generated compile-time benchmark sources.
+inline bool IsEven(int _value)
+{
+	return _value % 2 == 0;
+}
+
+inline int Half(int _value)
+{
+	return _value / 2;
+}
+
+struct Value
+{
+	int value = 0;
+
+	bool IsEven() const
+	{
+		return value % 2 == 0;
+	}
+
+	int Divide(int _divisor) const
+	{
+		return value / _divisor;
+	}
+};
+
+inline std::ostream& operator<<(std::ostream& _stream, const Value& _value)
+{
+	return _stream << _value.value;
+}
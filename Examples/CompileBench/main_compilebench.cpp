@@ -0,0 +1,203 @@
+// Copyright (c) 2021 Sapphire's Suite. All Rights Reserved.. All Rights Reserved.
+
+#include <UnitTestHelper.hpp>
+using namespace Sa;
+
+#include <iomanip>
+
+#define LOG(_str) std::cout << _str << std::endl;
+
+/**
+*	Measure the build cost of the assertion macros.
+*	Build every generated source (see CMakeLists.txt) and report compile time and object size.
+*	Results (baseline header include subtracted) are written in Logs/compile_bench_UTH.csv: compile time is tracked from its trend (CI artifact).
+*	Only object size is checked against a threshold: compile time depends on runner load, compiler version and caching.
+*
+*	Thresholds are about 2x the values measured per build type:
+*	Release:	495-690 bytes per assertion (2.4-8 ms per assertion, 1000 and 10000 assertions per source).
+*	Debug:		1720-1945 bytes per assertion (1.7-3.7 ms per assertion, 1000 assertions per source).
+*/
+#ifdef NDEBUG
+
+/// Max object size per assertion (in bytes, including debug info).
+const double maxBytesPerAssertion = 1536.0;
+
+#else
+
+const double maxBytesPerAssertion = 4096.0;
+
+#endif
+
+
+/// Generated source target.
+struct BenchTarget
+{
+	std::string name;
+	std::string kind;
+	unsigned int count = 0u;
+	std::string object;
+
+	/// Compile time (in seconds).
+	double time = 0.0;
+
+	/// Object size (in bytes).
+	uintmax_t size = 0u;
+};
+
+/// Command line settings.
+struct BenchSettings
+{
+	std::string cmake;
+	std::string buildDir;
+	std::string config;
+};
+
+/**
+*	\brief Parse targets file generated by CMake (one "name|kind|count|object" per line).
+*
+*	\param[in] _fileName	Path of the targets file.
+*
+*	\return Parsed targets (baseline first).
+*/
+std::vector<BenchTarget> ParseTargets(const std::string& _fileName)
+{
+	std::vector<BenchTarget> targets;
+	std::ifstream file(_fileName);
+	std::string line;
+
+	while (std::getline(file, line))
+	{
+		std::vector<std::string> fields;
+		size_t begin = 0u;
+
+		for (size_t end = line.find('|'); end != std::string::npos; end = line.find('|', begin))
+		{
+			fields.push_back(line.substr(begin, end - begin));
+			begin = end + 1u;
+		}
+
+		fields.push_back(line.substr(begin));
+
+		if (fields.size() != 4u)
+			continue;
+
+		BenchTarget target;
+		target.name = fields[0];
+		target.kind = fields[1];
+		target.count = static_cast<unsigned int>(std::stoul(fields[2]));
+		target.object = fields[3];
+
+		targets.push_back(target);
+	}
+
+	return targets;
+}
+
+/**
+*	\brief Build a single target from scratch.
+*
+*	\param[in,out] _target	Target to build: time and size are set.
+*	\param[in] _settings	Build settings.
+*
+*	\return Build command result.
+*/
+int BuildTarget(BenchTarget& _target, const BenchSettings& _settings)
+{
+	// Force compilation.
+	std::error_code error;
+	std::filesystem::remove(_target.object, error);
+
+	std::string command = '"' + _settings.cmake + "\" --build \"" + _settings.buildDir + "\" --target " + _target.name;
+
+	if (!_settings.config.empty())
+		command += " --config " + _settings.config;
+
+#if _WIN32
+	// cmd.exe strips the outer quotes.
+	command = '"' + command + '"';
+#endif
+
+	const auto start = std::chrono::steady_clock::now();
+
+	const int result = std::system(command.c_str());
+
+	_target.time = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	_target.size = std::filesystem::exists(_target.object, error) ? std::filesystem::file_size(_target.object, error) : 0u;
+
+	return result;
+}
+
+void CompileBenchs(std::vector<BenchTarget>& _targets, const BenchSettings& _settings)
+{
+	for (auto it = _targets.begin(); it != _targets.end(); ++it)
+	{
+		LOG("Building " << it->name << "...");
+
+		const int result = BuildTarget(*it, _settings);
+		SA_UTH_OP(result, ==, 0);
+	}
+
+
+	// Header include cost.
+	const BenchTarget* baseline = nullptr;
+
+	for (auto it = _targets.begin(); it != _targets.end(); ++it)
+	{
+		if (it->count == 0u)
+			baseline = &*it;
+	}
+
+	const double baseTime = baseline ? baseline->time : 0.0;
+	const double baseSize = baseline ? static_cast<double>(baseline->size) : 0.0;
+
+
+	std::filesystem::create_directories("Logs");
+	std::ofstream csv("Logs/compile_bench_UTH.csv", std::ios::out | std::ios::trunc);
+	csv << "kind,count,seconds,bytes\n";
+
+	LOG(std::left << std::setw(8) << "Kind" << std::right << std::setw(8) << "Count" << std::setw(12) << "Time (s)" <<
+		std::setw(14) << "Size (KiB)" << std::setw(14) << "ms/assert" << std::setw(14) << "bytes/assert");
+
+	for (auto it = _targets.begin(); it != _targets.end(); ++it)
+	{
+		csv << it->kind << ',' << it->count << ',' << it->time << ',' << it->size << '\n';
+
+		const double msPerAssertion = it->count ? (it->time - baseTime) * 1000.0 / it->count : 0.0;
+		const double bytesPerAssertion = it->count ? (static_cast<double>(it->size) - baseSize) / it->count : 0.0;
+
+		LOG(std::left << std::setw(8) << it->kind << std::right << std::setw(8) << it->count <<
+			std::fixed << std::setprecision(2) << std::setw(12) << it->time << std::setw(14) << it->size / 1024.0 <<
+			std::setw(14) << msPerAssertion << std::setw(14) << bytesPerAssertion);
+
+		if (it->count)
+			SA_UTH_OP(bytesPerAssertion, <, maxBytesPerAssertion);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	SA_UTH_INIT();
+
+	// Only output failed thresholds and group results.
+	UTH::verbosity &= ~UTH::Verbosity::Success;
+
+	if (argc < 4)
+	{
+		LOG("Usage: SA-UTH_CompileBench <targets file> <cmake> <build dir> [config]");
+		return EXIT_FAILURE;
+	}
+
+	BenchSettings settings;
+	settings.cmake = argv[2];
+	settings.buildDir = argv[3];
+	settings.config = argc > 4 ? argv[4] : "";
+
+	std::vector<BenchTarget> targets = ParseTargets(argv[1]);
+
+	SA_UTH_OP(targets.size(), >, 1u);
+
+	SA_UTH_GP(CompileBenchs(targets, settings));
+
+
+	SA_UTH_EXIT();
+}
@@ -98,6 +98,9 @@ void MainTests()
 	// Reset to Default.
 	UTH::verbosity = UTH::Default;
 
+	// Output call stack of each failure on exit (symbols exported in CMakeLists.txt).
+	UTH::verbosity |= UTH::Verbosity::FailureStack;
+
 
 
 	// Vec2 Tests.
@@ -25,14 +25,153 @@ void GroupTests_Failure()
 	SA_UTH_GPE();
 }
 
+/// Methods timing pipeline stages with zones.
+void GroupTests_Zones()
+{
+	std::vector<int> values;
+
+	for (int i = 0; i < 100; ++i)
+	{
+		SA_UTH_ZONE("Pipeline");
+
+		{
+			SA_UTH_ZONE("Generate");
+
+			values.clear();
+
+			for (int j = 0; j < 1000; ++j)
+				values.push_back(rand());
+		}
+
+		{
+			SA_UTH_ZONE("Sort");
+			std::sort(values.begin(), values.end());
+		}
+	}
+
+	SA_UTH_SF(std::is_sorted, values.begin(), values.end());
+}
+
+bool IsValidSample(int _value)
+{
+	return (_value * _value) % 250 != 0;
+}
+
+/// Methods validating many values.
+void GroupTests_Validation()
+{
+	int i = 5;
+	int j = 9;
+	SA_UTH_EQ(i, j); // Error.
+
+	for (int k = 1; k < 1000; ++k)
+		SA_UTH_SF(IsValidSample, k); // Error: every multiple of 50.
+}
+
+/// Methods running tests from multiple threads.
+void GroupTests_Threads()
+{
+	std::vector<std::thread> threads;
+
+	for (int t = 0; t < 4; ++t)
+	{
+		threads.emplace_back([t]()
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				SA_UTH_LOG("Worker " << t << " step " << i);
+				SA_UTH_OP(i, <, 3);
+			}
+		});
+	}
+
+	for (auto& thread : threads)
+		thread.join();
+}
+
+/// Methods allocating too much memory.
+void GroupTests_Allocate()
+{
+	std::vector<char> big(512u * 1024u * 1024u, 1);
+	SA_UTH_EQ(big[0], char(1));
+}
+
+/// Allocation failing in a nested group.
+void GroupTests_Memory()
+{
+	SA_UTH_GP(GroupTests_Allocate());
+}
+
+/// Methods spinning for too long.
+void GroupTests_CpuTime()
+{
+	volatile unsigned long long i = 0u;
+
+	while (true)
+		i = i + 1u;
+}
+
 int main()
 {
 	SA_UTH_INIT();
 
+	// Live counters readable by uth-top (memory-mapped page, removed on exit).
+	UTH::StatsPage::Open();
+
+	// Single console line with groups done, rate, failures and ETA (only when stdout is a TTY).
+	UTH::Progress::Start();
+
 
 	SA_UTH_GP(GroupTests_Success());
 	SA_UTH_GP(GroupTests_Failure());
 
 
+	// Output group resource usage (CPU time, page faults, context switches, block I/O).
+	UTH::verbosity |= UTH::GroupUsage;
+
+	SA_UTH_GP(GroupTests_Success());
+
+
+	// Output per-zone stats (count, total, mean, max) on group exit.
+	SA_UTH_GP(GroupTests_Zones());
+
+
+	// Logs of other threads are buffered per thread and output on group boundaries (no interleaving).
+	SA_UTH_GP(GroupTests_Threads());
+
+
+	// Keep logs in memory: only output the logs leading to a failure (or a crash).
+	UTH::bFlightRecorder = true;
+
+	SA_UTH_GP(GroupTests_Success());
+	SA_UTH_GP(GroupTests_Failure());
+
+	UTH::bFlightRecorder = false;
+
+
+	// Soft assertions: failures are recorded and output in a single sorted report on group end.
+	UTH::bSoftAssert = true;
+	UTH::verbosity &= ~UTH::Success;
+
+	SA_UTH_GP(GroupTests_Validation());
+
+	UTH::verbosity |= UTH::Success;
+	UTH::bSoftAssert = false;
+
+
+	// Run groups in isolated child processes under memory (256 MiB) and CPU time (1s) limits.
+	UTH::GroupLimits limits;
+	limits.memory = 256u * 1024u * 1024u;
+	limits.cpuTime = 1u;
+
+	SA_UTH_GP_LIMITS(GroupTests_Success(), limits);
+	SA_UTH_GP_LIMITS(GroupTests_Memory(), limits); // Error: memory limit.
+
+#if !_WIN32
+	// Limits are not supported on Windows: would never stop.
+	SA_UTH_GP_LIMITS(GroupTests_CpuTime(), limits); // Error: CPU time limit.
+#endif
+
+
 	SA_UTH_EXIT();
 }
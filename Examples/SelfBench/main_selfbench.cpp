@@ -0,0 +1,401 @@
+// Copyright (c) 2021 Sapphire's Suite. All Rights Reserved.. All Rights Reserved.
+
+#include <UnitTestHelper.hpp>
+using namespace Sa;
+
+#include <iomanip>
+
+#define LOG(_str) std::cout << _str << std::endl;
+
+/**
+*	Measure the overhead of the framework itself.
+*	Every measure is checked against a threshold. Only enforced with SA_UTH_SELF_BENCH_GATE (CMake option, calibrated machines):
+*	otherwise measures over threshold are reported without failing the CTest (shared CI runners are too noisy).
+*
+*	Thresholds are 2-3x the worst values measured per build type (Linux GCC, shared machine):
+*	Release:	105-205 ns success, 120-230 ns failure, 1.7-2.3 us per param, 1.3 us per group, 390-570 K lines/s (FileSink).
+*	Debug:		300-530 ns success, 480-720 ns failure, 3.6-5.5 us per param, 3.8-4.3 us per group, 285-350 K lines/s (FileSink).
+*/
+#if SA_UTH_SELF_BENCH_GATE
+	#define SELF_BENCH_CHECK(_lhs, _op, _rhs) SA_UTH_OP(_lhs, _op, _rhs)
+#else
+	#define SELF_BENCH_CHECK(_lhs, _op, _rhs)\
+	{\
+		if (!((_lhs) _op (_rhs)))\
+			LOG("\t[SA-UTH] Over threshold: " << #_lhs << " = " << (_lhs) << " (expected " << #_op << ' ' << (_rhs) << ')');\
+	}
+#endif
+
+#ifdef NDEBUG
+
+/// Max ns per assertion on success path (no output).
+const double maxSuccessNs = 500.0;
+
+/// Max ns per assertion on failure path (no output).
+const double maxFailureNs = 700.0;
+
+/// Max ns per ComputeParam, per param (formatted to a discarding sink: 2 log lines per param).
+const double maxParamNs = 5000.0;
+
+/// Max ns per group begin / end (no output).
+const double maxGroupNs = 3000.0;
+
+/// Min log lines per second per sink.
+const double minLinesPerSec = 200000.0;
+
+#else
+
+const double maxSuccessNs = 1200.0;
+const double maxFailureNs = 1600.0;
+const double maxParamNs = 12000.0;
+const double maxGroupNs = 12000.0;
+const double minLinesPerSec = 120000.0;
+
+#endif
+
+
+/// Sink discarding every log.
+class NullSink : public UTH::Sink
+{
+public:
+	void Write(const std::string& _str) override
+	{
+		UTH::DoNotOptimize(_str);
+	}
+};
+
+/// Disable outputs and restore framework state (measured tests are not counted).
+class SilentScope
+{
+	const bool bCslLog = UTH::bCslLog;
+	const bool bFileLog = UTH::bFileLog;
+	const unsigned int verbosity = UTH::verbosity;
+	const int exit = UTH::exit;
+	const UTH::Counter globalCount = UTH::Intl::globalCount;
+	const UTH::Counter groupCount = UTH::Group::globalCount;
+
+public:
+	SilentScope(unsigned int _verbosity = UTH::Verbosity::Default)
+	{
+		UTH::bCslLog = false;
+		UTH::bFileLog = false;
+		UTH::verbosity = _verbosity;
+	}
+
+	~SilentScope()
+	{
+		UTH::bCslLog = bCslLog;
+		UTH::bFileLog = bFileLog;
+		UTH::verbosity = verbosity;
+		UTH::exit = exit;
+		UTH::Intl::globalCount = globalCount;
+		UTH::Group::globalCount = groupCount;
+	}
+};
+
+/**
+*	\brief Measure the time of a body call.
+*
+*	\param[in] _body	Body called with iteration index.
+*	\param[in] _count	Number of calls per run.
+*
+*	\return Best time of one call over runs (in nanoseconds).
+*/
+template <typename FuncT>
+double MeasureNs(FuncT&& _body, unsigned int _count)
+{
+	double best = (std::numeric_limits<double>::max)();
+
+	for (unsigned int run = 0u; run < 5u; ++run)
+	{
+		const uint64_t start = UTH::Timer::Start();
+
+		for (unsigned int i = 0u; i < _count; ++i)
+			_body(i);
+
+		const uint64_t stop = UTH::Timer::Stop();
+
+		best = (std::min)(best, UTH::Timer::Elapsed(start, stop) / _count);
+	}
+
+	return best;
+}
+
+void LogMeasure(const std::string& _name, double _value, const char* _unit)
+{
+	LOG("\t" << std::left << std::setw(28) << _name << std::right << std::setw(12) << std::fixed << std::setprecision(1) << _value << ' ' << _unit);
+}
+
+
+/// Tested functions.
+bool IsEven(int _value)
+{
+	return _value % 2 == 0;
+}
+
+int Half(int _value)
+{
+	return _value / 2;
+}
+
+struct Value
+{
+	int value = 0;
+
+	bool IsEven() const
+	{
+		return value % 2 == 0;
+	}
+
+	int Divide(int _divisor) const
+	{
+		return value / _divisor;
+	}
+};
+
+std::ostream& operator<<(std::ostream& _stream, const Value& _value)
+{
+	return _stream << _value.value;
+}
+
+
+/**
+*	\brief Measure every macro kind on success and failure path, inside a group.
+*	Must be called outside of any group (measured results would spread to the parent).
+*
+*	\param[in] _bSuccess	Measured path.
+*	\param[out] _results	ns per assertion per macro kind.
+*/
+void MeasureAssertions(bool _bSuccess, std::vector<std::pair<std::string, double>>& _results)
+{
+	// Failure stacks would be kept for every failure.
+	SilentScope silent(UTH::Verbosity::Default & ~UTH::Verbosity::FailureStack);
+
+	const unsigned int count = _bSuccess ? 100000u : 10000u;
+	const int offset = _bSuccess ? 0 : 1;
+
+	UTH::Group::Begin("SelfBench");
+
+	_results.emplace_back("SA_UTH_EQ", MeasureNs([offset](unsigned int _i)
+	{
+		const int i = static_cast<int>(_i) * 2;
+		const int j = i + offset;
+
+		SA_UTH_EQ(i, j);
+	}, count));
+
+	_results.emplace_back("SA_UTH_SF", MeasureNs([offset](unsigned int _i)
+	{
+		const int i = static_cast<int>(_i) * 2 + offset;
+
+		SA_UTH_SF(IsEven, i);
+	}, count));
+
+	_results.emplace_back("SA_UTH_RSF", MeasureNs([offset](unsigned int _i)
+	{
+		const int i = static_cast<int>(_i) * 2;
+		const int res = static_cast<int>(_i) + offset;
+
+		SA_UTH_RSF(res, Half, i);
+	}, count));
+
+	_results.emplace_back("SA_UTH_MF", MeasureNs([offset](unsigned int _i)
+	{
+		const Value v{ static_cast<int>(_i) * 2 + offset };
+
+		SA_UTH_MF(v, IsEven);
+	}, count));
+
+	_results.emplace_back("SA_UTH_RMF", MeasureNs([offset](unsigned int _i)
+	{
+		const Value v{ static_cast<int>(_i) * 2 };
+		const int res = static_cast<int>(_i) + offset;
+
+		SA_UTH_RMF(res, v, Divide, 2);
+	}, count));
+
+	_results.emplace_back("SA_UTH_OP", MeasureNs([offset](unsigned int _i)
+	{
+		const int i = static_cast<int>(_i);
+		const int j = i + 1 - offset;
+
+		SA_UTH_OP(i, <, j);
+	}, count));
+
+	_results.emplace_back("SA_UTH_ROP", MeasureNs([offset](unsigned int _i)
+	{
+		const int i = static_cast<int>(_i);
+		const int res = i * 2 + offset;
+
+		SA_UTH_ROP(res, i, +, i);
+	}, count));
+
+	UTH::Group::End();
+}
+
+/// Measure ComputeParam with 1, 2, 4 and 8 params formatted to a discarding sink.
+void MeasureParams(std::vector<std::pair<std::string, double>>& _results)
+{
+	SilentScope silent;
+
+	NullSink nullSink;
+	UTH::AddSink(nullSink);
+
+	const unsigned int count = 2000u;
+
+	_results.emplace_back("ComputeParam(1)", MeasureNs([](unsigned int _i)
+	{
+		UTH::Intl::ComputeParam(false, "a", _i);
+	}, count));
+
+	_results.emplace_back("ComputeParam(2)", MeasureNs([](unsigned int _i)
+	{
+		UTH::Intl::ComputeParam(false, "a, b", _i, _i);
+	}, count));
+
+	_results.emplace_back("ComputeParam(4)", MeasureNs([](unsigned int _i)
+	{
+		UTH::Intl::ComputeParam(false, "a, b, c, d", _i, _i, _i, _i);
+	}, count));
+
+	_results.emplace_back("ComputeParam(8)", MeasureNs([](unsigned int _i)
+	{
+		UTH::Intl::ComputeParam(false, "a, b, c, d, e, f, g, h", _i, _i, _i, _i, _i, _i, _i, _i);
+	}, count));
+
+	UTH::RemoveSink(nullSink);
+}
+
+/// Measure group begin + end.
+double MeasureGroup()
+{
+	SilentScope silent;
+
+	return MeasureNs([](unsigned int)
+	{
+		UTH::Group::Begin("SelfBench");
+		UTH::Group::End();
+	}, 10000u);
+}
+
+/**
+*	\brief Measure log lines per second written to a single sink.
+*
+*	\param[in] _sink	Only enabled sink.
+*
+*	\return Lines per second.
+*/
+double MeasureLogLines(UTH::Sink& _sink)
+{
+	SilentScope silent;
+
+	UTH::AddSink(_sink);
+
+	const double ns = MeasureNs([](unsigned int _i)
+	{
+		SA_UTH_LOG("[SA-UTH] Self bench log line: " << _i);
+	}, 10000u);
+
+	_sink.Flush();
+	UTH::RemoveSink(_sink);
+
+	return ns > 0.0 ? 1e9 / ns : 0.0;
+}
+
+
+void AssertionBenchs(const std::vector<std::pair<std::string, double>>& _success, const std::vector<std::pair<std::string, double>>& _failure)
+{
+	LOG("Assertion success path (ns):");
+
+	for (auto it = _success.begin(); it != _success.end(); ++it)
+	{
+		LogMeasure(it->first, it->second, "ns");
+
+		const double ns = it->second;
+		SELF_BENCH_CHECK(ns, <, maxSuccessNs);
+	}
+
+
+	LOG("Assertion failure path (ns):");
+
+	for (auto it = _failure.begin(); it != _failure.end(); ++it)
+	{
+		LogMeasure(it->first, it->second, "ns");
+
+		const double ns = it->second;
+		SELF_BENCH_CHECK(ns, <, maxFailureNs);
+	}
+}
+
+void ParamBenchs()
+{
+	std::vector<std::pair<std::string, double>> params;
+	MeasureParams(params);
+
+	LOG("ComputeParam (ns):");
+
+	const unsigned int paramCounts[] = { 1u, 2u, 4u, 8u };
+
+	for (size_t i = 0u; i < params.size(); ++i)
+	{
+		LogMeasure(params[i].first, params[i].second, "ns");
+
+		const double nsPerParam = params[i].second / paramCounts[i];
+		SELF_BENCH_CHECK(nsPerParam, <, maxParamNs);
+	}
+}
+
+void GroupBenchs()
+{
+	const double ns = MeasureGroup();
+
+	LOG("Group:");
+	LogMeasure("Begin + End", ns, "ns");
+
+	SELF_BENCH_CHECK(ns, <, maxGroupNs);
+}
+
+void LogBenchs()
+{
+	LOG("Log throughput (lines/s):");
+
+	NullSink nullSink;
+	const double nullRate = MeasureLogLines(nullSink);
+	LogMeasure("NullSink", nullRate, "lines/s");
+	SELF_BENCH_CHECK(nullRate, >, minLinesPerSec);
+
+	UTH::MemorySink memorySink;
+	const double memoryRate = MeasureLogLines(memorySink);
+	LogMeasure("MemorySink", memoryRate, "lines/s");
+	SELF_BENCH_CHECK(memoryRate, >, minLinesPerSec);
+
+	std::filesystem::create_directories("Logs");
+
+	UTH::FileSink fileSink("Logs/selfbench_UTH.txt");
+	const double fileRate = MeasureLogLines(fileSink);
+	LogMeasure("FileSink", fileRate, "lines/s");
+	SELF_BENCH_CHECK(fileRate, >, minLinesPerSec);
+}
+
+int main()
+{
+	SA_UTH_INIT();
+
+	// Only output failed thresholds and group results.
+	UTH::verbosity &= ~UTH::Verbosity::Success;
+
+
+	std::vector<std::pair<std::string, double>> success;
+	MeasureAssertions(true, success);
+
+	std::vector<std::pair<std::string, double>> failure;
+	MeasureAssertions(false, failure);
+
+	SA_UTH_GP(AssertionBenchs(success, failure));
+	SA_UTH_GP(ParamBenchs());
+	SA_UTH_GP(GroupBenchs());
+	SA_UTH_GP(LogBenchs());
+
+
+	SA_UTH_EXIT();
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2021 Sapphire's Suite. All Rights Reserved.. All Rights Reserved.
+
+#include <UnitTestHelper.hpp>
+using namespace Sa;
+
+#define LOG(_str) std::cout << _str << std::endl;
+
+void LineCB(const std::string& _line, void* _userData)
+{
+	int& lineCount = *static_cast<int*>(_userData);
+	++lineCount;
+
+	(void)_line;
+}
+
+/// Custom sink: count characters written.
+class CountSink : public UTH::Sink
+{
+public:
+	size_t size = 0u;
+
+	void Write(const std::string& _str) override
+	{
+		size += _str.size();
+	}
+};
+
+/// Methods with all the tests (can be in a separated file).
+void MainTests()
+{
+	int i = 5;
+	int j = 9;
+
+	SA_UTH_EQ(i, i);
+	SA_UTH_EQ(i, j); // Error.
+}
+
+int main()
+{
+	SA_UTH_INIT();
+
+
+	// Everything is formatted for the file log, console only outputs failures and group exit.
+	UTH::verbosity = UTH::Verbosity::Max;
+	UTH::cslSink.verbosity = UTH::Verbosity::Light;
+
+	// Keep group results in memory.
+	UTH::MemorySink memorySink;
+	memorySink.verbosity = UTH::Verbosity::GroupExit;
+	UTH::AddSink(memorySink);
+
+	// Count log lines.
+	int lineCount = 0;
+	UTH::CallbackSink callbackSink(LineCB, &lineCount);
+	UTH::AddSink(callbackSink);
+
+	// Custom sink.
+	CountSink countSink;
+	UTH::AddSink(countSink);
+
+
+	SA_UTH_GP(MainTests());
+
+
+	UTH::RemoveSink(countSink);
+	UTH::RemoveSink(callbackSink);
+	UTH::RemoveSink(memorySink);
+
+	for (auto it = memorySink.lines.begin(); it != memorySink.lines.end(); ++it)
+		LOG("Memory: " << *it);
+
+	LOG("Callback: " << lineCount << " lines");
+	LOG("Custom: " << countSink.size << " characters");
+
+	UTH::verbosity = UTH::Verbosity::Default;
+
+
+	SA_UTH_EXIT();
+}
@@ -0,0 +1,271 @@
+// Copyright (c) 2021 Sapphire's Suite. All Rights Reserved.. All Rights Reserved.
+
+// Stats page layout only: no test runtime (log file, timer calibration).
+#include <UnitTestHelperStats.hpp>
+using namespace Sa;
+
+#include <cstdlib>
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+
+#if !_WIN32
+	#include <sys/stat.h>
+	#include <sys/mman.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+#endif
+
+#define LOG(_str) std::cout << _str << std::endl;
+
+/**
+*	uth-top: live monitor of a running test process.
+*	Attach to the stats page opened with UTH::StatsPage::Open() (or SA_UTH_DFLT_STATS_PAGE) and
+*	display counters, rates, current group path and worker threads.
+*
+*	Usage: uth-top [path] [--once] [--interval <ms>]
+*	Without path, attach to the most recent /dev/shm/sa_uth-* (or Logs/stats_UTH-*.shm) page.
+*/
+
+/// Command line settings.
+struct TopSettings
+{
+	std::string path;
+
+	/// Print a single sample and exit.
+	bool bOnce = false;
+
+	/// Refresh interval (in milliseconds).
+	unsigned int interval = 500u;
+};
+
+/// Sampled counters, used to compute rates.
+struct TopSample
+{
+	std::chrono::steady_clock::time_point time;
+
+	uint64_t tests = 0u;
+	uint64_t groups = 0u;
+};
+
+#if !_WIN32
+
+/**
+*	\brief Find the most recent stats page of a running process.
+*	Pages left by dead processes are removed.
+*
+*	\return Path of the page, empty if none found.
+*/
+std::string FindStatsPage()
+{
+	if (const size_t removed = UTH::StatsFile::RemoveStale())
+		LOG("uth-top: removed " << removed << " stale stats page(s).");
+
+	std::string found;
+	std::filesystem::file_time_type foundTime;
+
+	const auto search = [&found, &foundTime](const std::string& _dir, const std::string& _prefix)
+	{
+		std::error_code error;
+
+		for (std::filesystem::directory_iterator it(_dir, error), end; !error && it != end; it.increment(error))
+		{
+			if (it->path().filename().string().rfind(_prefix, 0) != 0)
+				continue;
+
+			// Not removed (permissions): still skipped.
+			const int64_t pid = UTH::StatsFile::PagePid(it->path().string());
+
+			if (pid > 0 && !UTH::StatsFile::IsAlive(pid))
+				continue;
+
+			const std::filesystem::file_time_type time = it->last_write_time(error);
+
+			if (!error && (found.empty() || time > foundTime))
+			{
+				found = it->path().string();
+				foundTime = time;
+			}
+		}
+	};
+
+	search("/dev/shm", "sa_uth-");
+	search("Logs", "stats_UTH-");
+
+	return found;
+}
+
+/**
+*	\brief Print one sample of the stats page.
+*
+*	\param[in] _data		Mapped stats page.
+*	\param[in,out] _prev	Previous sample (rates), updated.
+*/
+void PrintSample(const UTH::StatsData& _data, TopSample& _prev)
+{
+	using namespace std::chrono;
+
+	const uint64_t success = _data.success.load(std::memory_order_relaxed);
+	const uint64_t failure = _data.failure.load(std::memory_order_relaxed);
+	const uint64_t groupSuccess = _data.groupSuccess.load(std::memory_order_relaxed);
+	const uint64_t groupFailure = _data.groupFailure.load(std::memory_order_relaxed);
+
+	TopSample sample;
+	sample.time = steady_clock::now();
+	sample.tests = success + failure;
+	sample.groups = groupSuccess + groupFailure;
+
+	const double seconds = duration<double>(sample.time - _prev.time).count();
+	const double testRate = seconds > 0.0 ? (sample.tests - _prev.tests) / seconds : 0.0;
+	const double groupRate = seconds > 0.0 ? (sample.groups - _prev.groups) / seconds : 0.0;
+
+	_prev = sample;
+
+	const int64_t nowNs = duration_cast<nanoseconds>(system_clock::now().time_since_epoch()).count();
+	const uint32_t state = _data.state.load(std::memory_order_acquire);
+
+	LOG("uth-top - pid " << _data.pid << (state ? " (exited)" : " (running)") << " - uptime " << std::fixed << std::setprecision(1) <<
+		(nowNs - _data.startNs) / 1e9 << " s");
+	LOG("Tests:  " << success << " success, " << failure << " failure (" << std::setprecision(0) << testRate << " /s)");
+	LOG("Groups: " << groupSuccess << " success, " << groupFailure << " failure (" << groupRate << " /s)");
+	LOG("Group:  " << _data.PathName(_data.pathId.load(std::memory_order_relaxed)));
+	LOG("");
+
+	LOG(std::left << std::setw(8) << "Thread" << std::right << std::setw(12) << "Success" << std::setw(12) << "Failure" << "  Group");
+
+	for (uint32_t i = 0u; i < UTH::StatsData::maxWorkers; ++i)
+	{
+		const UTH::StatsWorker& worker = _data.workers[i];
+		const uint32_t tid = worker.tid.load(std::memory_order_relaxed);
+
+		if (!tid)
+			continue;
+
+		LOG(std::left << std::setw(8) << ('#' + std::to_string(tid - 1u)) << std::right <<
+			std::setw(12) << worker.success.load(std::memory_order_relaxed) <<
+			std::setw(12) << worker.failure.load(std::memory_order_relaxed) <<
+			"  " << _data.PathName(worker.pathId.load(std::memory_order_relaxed)));
+	}
+}
+
+int Run(const TopSettings& _settings)
+{
+	const std::string path = _settings.path.empty() ? FindStatsPage() : _settings.path;
+
+	if (path.empty())
+	{
+		LOG("uth-top: no stats page found (open one with UTH::StatsPage::Open()).");
+		return EXIT_FAILURE;
+	}
+
+	const int fd = open(path.c_str(), O_RDONLY);
+
+	if (fd < 0)
+	{
+		LOG("uth-top: can't open " << path);
+		return EXIT_FAILURE;
+	}
+
+	struct stat info{};
+
+	if (fstat(fd, &info) != 0 || static_cast<size_t>(info.st_size) < sizeof(UTH::StatsData))
+	{
+		close(fd);
+		LOG("uth-top: " << path << " is not a stats page");
+		return EXIT_FAILURE;
+	}
+
+	void* const map = mmap(nullptr, sizeof(UTH::StatsData), PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+
+	if (map == MAP_FAILED)
+	{
+		LOG("uth-top: can't map " << path);
+		return EXIT_FAILURE;
+	}
+
+	const UTH::StatsData& data = *static_cast<const UTH::StatsData*>(map);
+
+	if (data.magic != UTH::StatsData::magicValue || data.version != UTH::StatsData::versionValue)
+	{
+		munmap(map, sizeof(UTH::StatsData));
+		LOG("uth-top: " << path << " has an unknown stats page format");
+		return EXIT_FAILURE;
+	}
+
+	TopSample prev;
+	prev.time = std::chrono::steady_clock::now();
+	prev.tests = data.success.load(std::memory_order_relaxed) + data.failure.load(std::memory_order_relaxed);
+	prev.groups = data.groupSuccess.load(std::memory_order_relaxed) + data.groupFailure.load(std::memory_order_relaxed);
+
+	while (true)
+	{
+		if (!_settings.bOnce)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(_settings.interval));
+
+			// Clear screen.
+			std::cout << "\033[H\033[2J";
+		}
+
+		PrintSample(data, prev);
+
+		if (_settings.bOnce || data.state.load(std::memory_order_acquire) != 0u)
+			break;
+
+		if (!UTH::StatsFile::IsAlive(data.pid))
+		{
+			LOG("uth-top: process " << data.pid << " died without exit.");
+			break;
+		}
+	}
+
+	munmap(map, sizeof(UTH::StatsData));
+
+	return EXIT_SUCCESS;
+}
+
+#endif
+
+int main(int argc, char* argv[])
+{
+	const char* const usage = "Usage: uth-top [path] [--once] [--interval <ms>]";
+
+	TopSettings settings;
+
+	for (int i = 1; i < argc; ++i)
+	{
+		const std::string arg = argv[i];
+
+		if (arg == "--once")
+			settings.bOnce = true;
+		else if (arg == "--interval" && i + 1 < argc)
+		{
+			try
+			{
+				settings.interval = static_cast<unsigned int>((std::max)(std::stoul(argv[++i]), 10ul));
+			}
+			catch (const std::exception&)
+			{
+				LOG("uth-top: invalid interval " << argv[i]);
+				LOG(usage);
+				return EXIT_FAILURE;
+			}
+		}
+		else if (arg == "--help" || arg == "-h")
+		{
+			LOG(usage);
+			return EXIT_SUCCESS;
+		}
+		else
+			settings.path = arg;
+	}
+
+#if _WIN32
+	LOG("uth-top: stats page is not supported on Windows.");
+	return EXIT_FAILURE;
+#else
+	return Run(settings);
+#endif
+}
@@ -6,19 +6,106 @@
 #ifndef SAPPHIRE_UNIT_TEST_HELPER_GUARD
 #define SAPPHIRE_UNIT_TEST_HELPER_GUARD
 
-#include <stack>
+#include <deque>
 #include <vector>
+#include <unordered_map>
+#include <memory>
+#include <algorithm>
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstdint>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+#include <type_traits>
 
 #include <string>
+#include <string_view>
 #include <string.h> // Requiered for strrchr.
+#include <sstream>
+#include <iomanip>
 #include <iostream>
 
 #include <fstream>
 #include <filesystem>
 
+#include <csignal>
+
 #if _WIN32
 
+// Keep std::min / std::max usable.
+#ifndef NOMINMAX
+	#define NOMINMAX
+#endif
+
+#ifndef WIN32_LEAN_AND_MEAN
+	#define WIN32_LEAN_AND_MEAN
+#endif
+
 #include <Windows.h>
+#include <intrin.h> // Requiered for _ReadWriteBarrier.
+#include <io.h> // Requiered for _isatty.
+
+#else
+
+#include <pthread.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include <sys/resource.h>
+#include <sys/mman.h> // Requiered for mmap.
+#include <fcntl.h>
+
+#endif
+
+#if __linux__
+
+#include <sched.h>
+#include <time.h> // Requiered for timer_create.
+
+#endif
+
+#if !_WIN32 && __has_include(<execinfo.h>)
+
+#include <execinfo.h> // Requiered for backtrace.
+#include <cxxabi.h> // Requiered for symbol demangling.
+#include <sys/time.h>
+#include <errno.h>
+
+/// Call stack capture support.
+#define SA_UTH_BACKTRACE 1
+
+#else
+
+#define SA_UTH_BACKTRACE 0
+
+#endif
+
+#if _MSC_VER
+
+/// Keep a function out of its callers (fixed frame count).
+#define SA_UTH_NOINLINE __declspec(noinline)
+
+#else
+
+#define SA_UTH_NOINLINE __attribute__((noinline))
+
+#endif
+
+#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <xmmintrin.h> // Requiered for FTZ/DAZ control.
+
+#endif
+
+#if (defined(__x86_64__) || defined(__i386__)) && !_WIN32
+
+#include <cpuid.h>
+#include <x86intrin.h> // Requiered for rdtsc.
 
 #endif
 
@@ -28,6 +115,9 @@
 
 #endif
 
+// Stats page layout (shared with the uth-top monitor).
+#include "UnitTestHelperStats.hpp"
+
 /**
 *	\file UnitTestHelper.hpp
 *
@@ -132,15 +222,30 @@ namespace Sa
 			/// Output group counter on exit.
 			GroupCount = 1 << 6,
 
+			/// Output benchmark results.
+			BenchResult = 1 << 7,
+
+			/// Output group duration on exit.
+			GroupTime = 1 << 8,
+
+			/// Output group resource usage on exit.
+			GroupUsage = 1 << 9,
+
+			/// Output group zone stats on exit.
+			GroupZones = 1 << 10,
+
+			/// Capture call stack on failure, output on exit.
+			FailureStack = 1 << 11,
+
 
 			/// Light verbosity value.
 			Light = ParamsName | ParamsFailure | GroupExit,
 
 			/// Default verbosity value.
-			Default = Success | ParamsName | ParamsFailure | GroupStart | GroupExit | GroupCount,
+			Default = Success | ParamsName | ParamsFailure | GroupStart | GroupExit | GroupCount | BenchResult | GroupZones,
 
 			/// Maximum verbosity level (all flags set).
-			Max = 0xFF
+			Max = 0xFFFF
 		};
 
 		/// Current verbosity level.
@@ -174,6 +279,33 @@ namespace Sa
 		/// Dynamic file log toogle.
 		inline bool bFileLog = SA_UTH_DFLT_FILE_LOG;
 
+
+#ifndef SA_UTH_DFLT_TRACE
+		/**
+		*	\brief Wether to write a Chrome trace (Perfetto timeline) in Logs/ by default.
+		*	Can be defined within cmake options or before including the header.
+		*/
+		#define SA_UTH_DFLT_TRACE 0
+#endif
+
+		/// Dynamic trace toogle.
+		inline bool bTrace = SA_UTH_DFLT_TRACE;
+
+
+#ifndef SA_UTH_DFLT_FLIGHT_RECORDER
+		/**
+		*	\brief Wether to keep logs in memory and only output them on failure or crash by default.
+		*	Can be defined within cmake options or before including the header.
+		*/
+		#define SA_UTH_DFLT_FLIGHT_RECORDER 0
+#endif
+
+		/// Dynamic flight recorder toogle: logs are kept in a per-thread ring and output on failure or crash only.
+		inline bool bFlightRecorder = SA_UTH_DFLT_FLIGHT_RECORDER;
+
+		/// Number of log records kept per thread by the flight recorder.
+		inline unsigned int flightRecorderSize = 256u;
+
 		/// \cond Internal
 
 		/// Internal implementation namespace.
@@ -195,6 +327,167 @@ namespace Sa
 			inline Logger Logger::instance;
 
 
+			/**
+			*	\brief In-memory ring of the last log records of each thread.
+			*
+			*	Records are output on failure (records of the failing thread) or on crash (every thread), then cleared.
+			*/
+			class FlightRecorder
+			{
+				/// Log line with its verbosity flag.
+				struct Record
+				{
+					std::string text;
+					unsigned int flag = 0u;
+				};
+
+				/// Records of a single thread.
+				struct Ring
+				{
+					std::mutex mutex;
+					std::vector<Record> records;
+
+					/// Index of the next record to write.
+					size_t next = 0u;
+
+					/// Line being written (no end of line yet).
+					std::string line;
+
+					unsigned int tid = 0u;
+				};
+
+				static inline std::mutex ringsMutex;
+				static inline std::vector<std::shared_ptr<Ring>> rings;
+
+				/// Ring of the current thread, registered on first use.
+				static inline Ring& LocalRing();
+
+				using SignalHandler = void (*)(int);
+
+				/// Signals dumping every ring.
+				static constexpr int crashSignals[] =
+				{
+					SIGSEGV, SIGABRT, SIGFPE, SIGILL,
+				#if !_WIN32
+					SIGBUS,
+				#endif
+				};
+
+				/// Handlers replaced by CrashHandler (same order as crashSignals).
+				static inline SignalHandler previousHandlers[sizeof(crashSignals) / sizeof(int)]{};
+
+				static inline bool bHandlersInstalled = false;
+
+				/// Whether _ring has records or a pending line.
+				static inline bool HasRecords(const Ring& _ring);
+
+				/// Output and clear records of _ring.
+				static inline void DumpRing(Ring& _ring);
+
+				/// Dump every ring then chain to the previous handler of _signal.
+				static inline void CrashHandler(int _signal);
+
+			public:
+				/// Append _str to the current thread ring (a record per line).
+				static inline void Write(const std::string& _str);
+
+				/**
+				*	\brief Output and clear recorded logs.
+				*
+				*	\param[in] _bAllThreads	Dump every thread ring or only the current thread one.
+				*/
+				static inline void Dump(bool _bAllThreads = false);
+
+				/**
+				*	\brief Output and clear recorded logs without header (logs following a dumped failure).
+				*
+				*	\param[in] _bAllThreads	Flush every thread ring or only the current thread one.
+				*/
+				static inline void Flush(bool _bAllThreads = false);
+
+				/// Restore signal handlers replaced by the crash handler.
+				static inline void RestoreHandlers();
+			};
+
+
+			/// Timer ticks of the timestamps origin (0 == not captured yet).
+			inline std::atomic<uint64_t> originTicks{ 0u };
+
+			/**
+			*	\brief Timestamps origin: captured on init, or from the first timestamp _ticks.
+			*	Never captured at static init (would calibrate the timer in every process).
+			*/
+			inline uint64_t OriginTicks(uint64_t _ticks) noexcept;
+
+
+			/**
+			*	\brief Chrome trace event writer (JSON array format, loadable in Perfetto).
+			*
+			*	Events are formatted in a buffer flushed to Logs/trace_UTH-<date>.json.
+			*	The file is only created on the first event.
+			*/
+			class Trace
+			{
+				std::ofstream traceFile;
+				std::string buffer;
+				std::mutex mutex;
+
+				bool bOpened = false;
+
+				Trace() = default;
+				inline ~Trace();
+
+				/// Append an event (lock must be held).
+				inline void Append(const std::string& _event);
+
+				/// Write buffer to file, opening it on first write (lock must be held).
+				inline void WriteBuffer();
+
+				/// Common event fields.
+				inline std::string EventHead(const std::string& _name, const char* _cat, char _phase, uint64_t _ticks, unsigned int _tid) const;
+
+			public:
+				static Trace instance;
+
+				/// Begin a duration event on the current thread.
+				inline void Begin(const std::string& _name, const char* _cat);
+
+				/// End the last duration event of the current thread.
+				inline void End(const std::string& _name, const char* _cat);
+
+				/**
+				*	\brief Complete event with duration.
+				*
+				*	\param[in] _name		Name of the event.
+				*	\param[in] _cat		Category of the event.
+				*	\param[in] _start		Timer ticks at event start.
+				*	\param[in] _stop		Timer ticks at event end.
+				*	\param[in] _args		JSON object of args (ex: {"n":1}) or empty.
+				*/
+				inline void Complete(const std::string& _name, const char* _cat, uint64_t _start, uint64_t _stop, const std::string& _args = std::string());
+
+				/// Complete event on trace thread _tid (recorded by another thread).
+				inline void Complete(unsigned int _tid, const std::string& _name, const char* _cat, uint64_t _start, uint64_t _stop, const std::string& _args = std::string());
+
+				/// Instant event on the current thread.
+				inline void Instant(const std::string& _name, const char* _cat, const std::string& _args = std::string());
+
+				/// Write buffered events to file.
+				inline void Flush();
+			};
+
+			inline Trace Trace::instance;
+
+			/// Escape string for JSON output.
+			inline std::string JsonEscape(const std::string& _str);
+
+			/// Small index of the current thread (0 == first thread using UTH).
+			inline unsigned int ThreadIndex() noexcept;
+
+			/// Current local date and time as string (ex: 2.27.2021-12h07m43s).
+			inline std::string DateStr();
+
+
 			/// enum for console colors.
 			enum class CslColor
 			{
@@ -227,6 +520,9 @@ namespace Sa
 
 				/// Color used for param warning.
 				ParamWarning,
+
+				/// Color used for benchmark results.
+				Bench,
 			};
 
 			inline void SetConsoleColor(CslColor _result);
@@ -251,1035 +547,7109 @@ namespace Sa
 			inline const char* GetFileNameFromPath(const char* _filePath) noexcept;
 		}
 
+		/// \endcond
+
 
 		/**
-		*	\brief UTH log macro
+		*	\brief Log output interface.
 		*
-		*	Output with indentation and options bCslLog and bFileLog.
+		*	Logs are formatted once then written to every enabled sink accepting their verbosity flag.
+		*	Custom sinks are registered with AddSink.
 		*/
-		#define SA_UTH_LOG(_str)\
-		{\
-			Sa::UTH::Group::LogTabs();\
-			if (Sa::UTH::bCslLog) std::cout << _str << std::endl;\
-			if (Sa::UTH::bFileLog) Sa::UTH::Intl::Logger::instance.logFile << _str << std::endl;\
-		}
+		class Sink
+		{
+		public:
+			/// Verbosity flags accepted by this sink (logs are first filtered by global verbosity).
+			unsigned int verbosity = Verbosity::Max;
 
-		/// Output only str as input.
-		#define __SA_UTH_LOG_IN(_str)\
-		{\
-			if (Sa::UTH::bCslLog) std::cout << _str;\
-			if (Sa::UTH::bFileLog) Sa::UTH::Intl::Logger::instance.logFile << _str;\
-		}
+			virtual ~Sink() = default;
 
-		/// Ouput only end of line.
-		#define __SA_UTH_LOG_ENDL()\
-		{\
-			if (Sa::UTH::bCslLog) std::cout << std::endl;\
-			if (Sa::UTH::bFileLog) Sa::UTH::Intl::Logger::instance.logFile << std::endl;\
-		}
+			/// Whether the sink currently receives logs.
+			virtual bool IsEnabled() const { return true; }
 
-//}
+			/**
+			*	\brief Write formatted log.
+			*
+			*	\param[in] _str	Log string: part of a line or end of line ('\n').
+			*/
+			virtual void Write(const std::string& _str) = 0;
 
+			/// Set output color (console only).
+			virtual void SetColor(Intl::CslColor _color) { (void)_color; }
 
-//{ Counter
+			/// Flush buffered output.
+			virtual void Flush() {}
 
-		struct Counter
+			/// Whether the sink accepts logs of verbosity flag _flag (0 == always output).
+			inline bool Accepts(unsigned int _flag) const noexcept;
+		};
+
+		/// Console sink (std::cout with colors), toggled by bCslLog.
+		class ConsoleSink : public Sink
 		{
-			/// Counter of success.
-			unsigned int success = 0;
+		public:
+			inline bool IsEnabled() const override;
+			inline void Write(const std::string& _str) override;
+			inline void SetColor(Intl::CslColor _color) override;
+			inline void Flush() override;
+		};
 
-			/// Counter of failure.
-			unsigned int failure = 0;
+		/// File sink: default log file (toggled by bFileLog) or custom file.
+		class FileSink : public Sink
+		{
+			std::ofstream file;
 
-			/// Total count.
-			inline unsigned int Total() const;
+		public:
+			/// Default log file sink (Logs/log_UTH-<date>.txt).
+			FileSink() = default;
 
-			/// Update counter from predicate.
-			inline void Update(bool _pred);
+			/**
+			*	\param[in] _fileName	Path of the custom log file (truncated).
+			*/
+			inline FileSink(const std::string& _fileName);
 
-			inline Counter& operator+=(const Counter& _rhs) noexcept;
+			inline bool IsEnabled() const override;
+			inline void Write(const std::string& _str) override;
+			inline void Flush() override;
+		};
 
-			inline void Log() const;
+		/// Memory sink: keep log lines in memory.
+		class MemorySink : public Sink
+		{
+			std::string line;
 
-			inline bool IsEmpty() const;
+		public:
+			/// Logged lines (without end of line).
+			std::vector<std::string> lines;
+
+			inline void Write(const std::string& _str) override;
+
+			/// Clear logged lines.
+			inline void Clear();
 		};
 
-//}
+		/// Callback sink: call a function for each log line.
+		class CallbackSink : public Sink
+		{
+			std::string line;
 
+		public:
+			/// Callback called for each log line (without end of line).
+			void (*callback)(const std::string& _line, void* _userData) = nullptr;
 
-//{ Title
+			/// User data given to callback.
+			void* userData = nullptr;
 
-		struct Title
-		{
-			const std::string& funcDecl;
-			const std::string& fileName;
-			unsigned int lineNum = 0u;
-			bool pred = false;
+			CallbackSink() = default;
 
-			/// Log test's title in console.
-			inline void Log() const;
+			/**
+			*	\param[in] _callback	Callback called for each log line.
+			*	\param[in] _userData	User data given to callback.
+			*/
+			inline CallbackSink(void (*_callback)(const std::string& _line, void* _userData), void* _userData = nullptr);
+
+			inline void Write(const std::string& _str) override;
 		};
 
-//}
+		/// Built-in console sink.
+		inline ConsoleSink cslSink;
 
+		/// Built-in log file sink.
+		inline FileSink fileSink;
 
-//{ Group
+		/**
+		*	\brief Register a sink.
+		*
+		*	\param[in] _sink	Sink to register. Not owned: must outlive its registration.
+		*/
+		inline void AddSink(Sink& _sink);
 
-		/// Infos generated from a group of tests.
-		class Group
-		{
-			static std::stack<Group> sGroups;
+		/// Unregister a sink.
+		inline void RemoveSink(Sink& _sink);
 
-		public:
+		/// \cond Internal
 
-			/// Name of the group.
-			const std::string name;
+		namespace Intl
+		{
+			/// Registered sinks.
+			inline std::vector<Sink*> sinks{ &cslSink, &fileSink };
 
-			/**
-			*	\brief Local exit from tests of the group.
-			*
-			*	UTH::localExit will be equal to EXIT_FAILURE (1) if at least one test of the group failed.
-			*
-			*	localExit 0 == success.
-			*	localExit 1 == failure.
-			*/
-			bool localExit = EXIT_SUCCESS;
+			/// Verbosity flag of the logs written by this thread (0 == always output).
+			inline thread_local unsigned int logFlag = 0u;
 
-			/// Counter of test run in this group.
-			Counter count{};
+			/// Set verbosity flag of the logs written in scope.
+			class LogFlagScope
+			{
+				unsigned int previous = 0u;
 
-			/// Global Group counter.
-			static inline Counter globalCount;
+			public:
+				inline explicit LogFlagScope(unsigned int _flag) noexcept;
+				inline ~LogFlagScope();
+			};
 
 			/**
-			*	\brief Spreads values to parent group.
-			*
-			*	\param[in] _parent	parent to spread values to.
+			*	Logs of this thread bypass the flight recorder and the thread log buffer (dump and crash output).
+			*	A crashing thread never merges its buffer.
+			*	Sinks are not locked: from another thread, only safe while the group thread waits (ex: join).
 			*/
-			inline void Spread(Group& _parent);
+			inline thread_local bool bDirectLog = false;
+
+			/// Write the logs of this thread in scope directly to sinks.
+			class DirectLogScope
+			{
+				bool previous = false;
+
+			public:
+				inline DirectLogScope() noexcept;
+				inline ~DirectLogScope();
+			};
 
 			/**
-			*	\brief Update values from predicate.
+			*	\brief Whether logs of verbosity flag _flag are output.
 			*
-			*	\param[in] _pred	predicate from current test.
+			*	\param[in] _flag	Verbosity flag of the log (0 == always output).
 			*/
-			static inline void Update(bool _pred);
+			inline bool ShouldLog(unsigned int _flag) noexcept;
 
-			/// Start a new group of tests.
-			static inline void Begin(const std::string& _name);
+			/// Write formatted string to sinks (or flight recorder, or thread log buffer, see bDirectLog).
+			inline void LogWrite(const std::string& _str);
 
-			/// End a group of tests.
-			static inline Group End();
+			/// Flush every sink.
+			inline void FlushSinks();
 
 
 			/**
-			*	\brief GroupBegin output in console.
+			*	\brief Private log buffers of the threads not running groups.
 			*
-			*	\param[in] _name	The name of the group that begins.
+			*	Logs of other threads are appended to a per-thread buffer tagged with the current group path (no shared lock).
+			*	Buffers are merged by the group thread at group boundaries and on exit:
+			*	ordered by group path (group begin order), then by thread index.
 			*/
-			static inline void BeginLog(const std::string& _name);
+			class ThreadLog
+			{
+				/// Log string (or color change) with its verbosity flag.
+				struct Entry
+				{
+					std::string text;
+					unsigned int flag = 0u;
+					uint32_t path = 0u;
 
-			/**
-			*	\brief GroupEnd output in console.
-			*
-			*	\param[in] _group	The group that ends.
-			*/
-			static inline void EndLog(const UTH::Group& _group);
+					/// Color change entry (text is empty).
+					bool bColor = false;
+					CslColor color = CslColor::None;
+				};
 
+				/// Entries of a single thread.
+				struct Buffer
+				{
+					std::mutex mutex;
+					std::vector<Entry> entries;
 
-			static inline std::string TabStr() noexcept;
+					unsigned int tid = 0u;
+				};
 
-			static inline void LogTabs() noexcept;
-		};
+				static inline std::mutex buffersMutex;
+				static inline std::vector<std::shared_ptr<Buffer>> buffers;
 
-		inline std::stack<Group> Group::sGroups;
+				/// Group paths (index == path id, 0 == out of any group).
+				static inline std::mutex pathsMutex;
+				static inline std::vector<std::string> paths{ std::string() };
 
-//}
+				/// Path ids of the running groups (group thread only).
+				static inline std::vector<uint32_t> pathStack;
 
+				static inline std::atomic<uint32_t> currentPath{ 0u };
 
-//{ Param
+				/// Thread running groups: writes directly to sinks.
+				static inline std::atomic<std::thread::id> owner{ std::this_thread::get_id() };
 
-		/// Pair of param name and value.
-		struct Param
-		{
-			/// Param's name.
-			std::string name;
+				/// Buffer of the current thread, registered on first use.
+				static inline Buffer& LocalBuffer();
 
-			/// Param's value as a string.
-			std::string value;
+			public:
+				/// Whether logs of the current thread are buffered.
+				static inline bool IsBuffered() noexcept;
 
-			/**
-			*	\brief Test parameters output in console.
-			*
-			*	\param[in] _params	Every param infos extracted from call.
-			*/
-			static inline void Log(const std::vector<Param>& _params);
-		};
+				/// Append _str to the current thread buffer.
+				static inline void Write(const std::string& _str);
 
-//}
+				/// Append color change to the current thread buffer.
+				static inline void SetColor(CslColor _color);
 
+				/**
+				*	\brief Enter group _name: tag next logs of other threads with its path.
+				*	The calling thread becomes the group thread.
+				*/
+				static inline void PushPath(const std::string& _name);
 
-//{ Callback
+				/// Exit current group path.
+				static inline void PopPath();
+
+				/// Output buffered logs of every thread (group thread only).
+				static inline void Merge();
+
+				/// Id of the current group path (0 == out of any group).
+				static inline uint32_t CurrentPathId() noexcept;
+
+				/// Group path of id _id (ex: "Parent/Child").
+				static inline std::string PathName(uint32_t _id);
+			};
+		}
+
+		/// \endcond
 
-		/// Pointer to allow user to get custom data in callbacks.
-		inline void* UserData = nullptr;
 
 		/**
-		*	\brief Helper get user data with type.
+		*	\brief UTH log macro
 		*
-		*	\tparam T	The type to cast user data.
+		*	Output with indentation and options bCslLog and bFileLog.
+		*/
+		#define SA_UTH_LOG(_str)\
+		{\
+			Sa::UTH::Group::LogTabs();\
+			__SA_UTH_LOG_IN(_str);\
+			__SA_UTH_LOG_ENDL();\
+		}
+
+		/// Output only str as input (formatted once for every sink).
+		#define __SA_UTH_LOG_IN(_str)\
+		{\
+			if (Sa::UTH::Intl::ShouldLog(Sa::UTH::Intl::logFlag))\
+			{\
+				std::ostringstream sLogStr;\
+				sLogStr << _str;\
+				Sa::UTH::Intl::LogWrite(sLogStr.str());\
+			}\
+		}
+
+		/// Ouput only end of line.
+		#define __SA_UTH_LOG_ENDL()\
+		{\
+			if (Sa::UTH::Intl::ShouldLog(Sa::UTH::Intl::logFlag))\
+				Sa::UTH::Intl::LogWrite("\n");\
+		}
+
+//}
+
+
+//{ Timer
+
+		/**
+		*	\brief Low-overhead timer.
 		*
-		*	\return User data casted as T.
+		*	Read the CPU counter (rdtsc/rdtscp on x86 with invariant TSC, cntvct on ARM64),
+		*	calibrated against std::chrono::steady_clock. Fallback on steady_clock otherwise, or when it is cheaper to read.
 		*/
-		template<typename T>
-		inline T& GetUserData() { return *reinterpret_cast<T*>(UserData); }
+		class Timer
+		{
+			/// Calibration infos.
+			struct Calibration
+			{
+				/// Duration of one tick (in nanoseconds).
+				double nsPerTick = 1.0;
 
-		/// Callback called on groupe begin.
-		inline void (*GroupBeginCB)(const std::string& _name) = nullptr;
+				/// Cost of a Start/Stop pair (in ticks).
+				double overhead = 0.0;
 
-		/// Callback called on groupe end.
-		inline void (*GroupEndCB)(const Group& _group) = nullptr;
+				/// Whether the CPU counter is used.
+				bool bCycleCounter = false;
+			};
 
-		/// Callback called on test's title processing.
-		inline void (*TitleCB)(const Title& _infos) = nullptr;
+			/// Calibrate once (thread-safe), on first call.
+			static inline const Calibration& GetCalibration();
 
-		/// Callback called on test's parameters processing.
-		inline void (*ParamsCB)(const std::vector<Param>& _params) = nullptr;
+			/// Read the timer at the start of a measure, using the CPU counter or not.
+			static inline uint64_t StartTicks(bool _bCycleCounter) noexcept;
 
-		/// Callback called on test's result processing.
-		inline void (*ResultCB)(bool _pred) = nullptr;
+			/// Read the timer at the end of a measure, using the CPU counter or not.
+			static inline uint64_t StopTicks(bool _bCycleCounter) noexcept;
+
+		public:
+			/// Read the timer at the start of a measure (in ticks).
+			static inline uint64_t Start() noexcept;
+
+			/// Read the timer at the end of a measure (in ticks).
+			static inline uint64_t Stop() noexcept;
+
+			/**
+			*	\brief Elapsed time between two reads, read overhead subtracted.
+			*
+			*	\param[in] _start	Ticks from Start().
+			*	\param[in] _stop	Ticks from Stop().
+			*
+			*	\return elapsed time (in nanoseconds).
+			*/
+			static inline double Elapsed(uint64_t _start, uint64_t _stop);
+
+			/// Convert ticks to nanoseconds.
+			static inline double ToNs(double _ticks);
+
+			/// Cost of a Start/Stop pair (in nanoseconds).
+			static inline double Overhead();
+
+			/// Whether the CPU counter is used (false: steady_clock fallback).
+			static inline bool IsCycleCounter();
+
+			/// Calibrate the timer now (called by Init) instead of on first use.
+			static inline void Calibrate();
+		};
 
 //}
 
 
-//{ ToString
+//{ Usage
 
-		namespace Intl
+		/// Resource usage of the current thread (getrusage).
+		struct Usage
 		{
+			/// CPU time spent in user mode (in nanoseconds).
+			double userTime = 0.0;
+
+			/// CPU time spent in kernel mode (in nanoseconds).
+			double sysTime = 0.0;
+
+			/// Page faults serviced without I/O.
+			long minorFaults = 0;
+
+			/// Page faults requiring I/O.
+			long majorFaults = 0;
+
+			/// Voluntary context switches (ex: waiting on a resource).
+			long voluntarySwitches = 0;
+
+			/// Involuntary context switches (ex: time slice expired).
+			long involuntarySwitches = 0;
+
+			/// Block input operations.
+			long blockInputs = 0;
+
+			/// Block output operations.
+			long blockOutputs = 0;
+
 			/**
-			*	Compile time check type T has member ToString using SFINAE.
-			* 
-			*	Source: https://github.com/SapphireSuite/Core/blob/main/Include/Core/Misc/HasMember.hpp
+			*	\brief Capture usage of the current thread.
+			*	Use the whole process where per-thread usage is not supported (ex: MacOS).
+			*	Only CPU times are supported on Windows.
 			*
+			*	\return Current usage.
 			*/
-			template <typename T>
-			class HM_ToString
-			{
-				/// SFINAE success type.
-				using Yes = char;
+			static inline Usage Capture() noexcept;
 
-				/// SFINAE failure type.
-				using No = char[2];
+			inline Usage operator-(const Usage& _rhs) const noexcept;
 
-				/// template deduction helper.
-				template<typename C, C> struct CheckT;
+			inline void Log() const;
+		};
 
-				/// Introduce Name member.
-				struct Fallback
-				{
-					/// Dummy variable with name Name for SFINAE deduction.
-					int ToString;
-				};
+//}
 
-				/// Merge T and Fallback members.
-				struct Derived : T, Fallback { };
 
-				template<typename C, C> struct ChT;
+//{ Counter
 
-				template <typename C>
-				static Yes& SFINAE(ChT<int Fallback::*, &C::ToString>* _c);
+		struct Counter
+		{
+			/// Counter of success (tests may run on several threads).
+			std::atomic<unsigned int> success{ 0u };
 
-				template <typename C>
-				static No& SFINAE(...);
+			/// Counter of failure (tests may run on several threads).
+			std::atomic<unsigned int> failure{ 0u };
 
-			public:
-				/// true if T as a public member called Name (ie: SFINAE failure), otherwise false.
-				static constexpr bool value = sizeof(SFINAE<Derived>(0)) == sizeof(No);
-			};
-		}
+			Counter() = default;
+			inline Counter(const Counter& _other) noexcept;
+			inline Counter& operator=(const Counter& _rhs) noexcept;
+
+			/// Total count.
+			inline unsigned int Total() const;
+
+			/// Update counter from predicate.
+			inline void Update(bool _pred);
+
+			inline Counter& operator+=(const Counter& _rhs) noexcept;
+
+			inline void Log() const;
+
+			inline bool IsEmpty() const;
+		};
+
+//}
+
+
+//{ Zone
+
+		/// Aggregated stats of a zone within a group.
+		struct ZoneStats
+		{
+			/// Name of the zone.
+			std::string name;
+
+			/// Number of runs of the zone.
+			uint64_t count = 0u;
+
+			/// Total duration (in nanoseconds).
+			double total = 0.0;
+
+			/// Longest run (in nanoseconds).
+			double max = 0.0;
+
+			/// Log stats in console.
+			inline void Log() const;
+		};
 
 		/**
-		*	\brief ToString implementation used to print elem during unit testing.
+		*	\brief RAII scope timing a span of a test body (see SA_UTH_ZONE).
 		*
-		*	Default implementation: helper to call Stringizer using template deduction.
-		*	Define template specialization for simple class custom implementation.
-		* 
-		*	\tparam T			Type of element.
-		*	\param[in] _elem	Element to convert to string.
-		*
-		*	\return	std::string from converted element using stringizer.
+		*	Spans are pushed without lock in a per-thread buffer, then flushed on group begin and end
+		*	into the group zone stats and the trace.
 		*/
-		template <typename T>
-		std::string ToString(const T& _elem)
+		class Zone
 		{
-			if constexpr (std::is_arithmetic<T>::value)
-				return std::to_string(_elem);
-			else if constexpr (std::is_enum<T>::value)
-				return std::to_string(static_cast<unsigned int>(_elem));
-			else if constexpr (std::is_pointer<T>::value)
-				return "0x" + std::to_string(reinterpret_cast<unsigned long long>(_elem));
-			else if constexpr (Intl::HM_ToString<T>::value)
-				return _elem.ToString();
-			else if constexpr (std::is_same<T, std::string>::value)
-				return _elem;
-			else
-			{
-#if SA_CORE_IMPL
-				return Sa::ToString(_elem);
-#else
-				return std::string();
+			const char* name = nullptr;
+			uint64_t start = 0u;
+
+		public:
+			/**
+			*	\param[in] _name	Name of the zone. Must outlive the group (string literal).
+			*/
+			inline Zone(const char* _name) noexcept;
+			inline ~Zone();
+
+			Zone(const Zone&) = delete;
+			Zone& operator=(const Zone&) = delete;
+		};
+
+#ifndef SA_UTH_ZONE_CAPACITY
+		/**
+		*	\brief Zone records buffered per thread between two group boundaries.
+		*	Can be defined before including the header.
+		*/
+		#define SA_UTH_ZONE_CAPACITY 4096
 #endif
-			}
+
+		/// \cond Internal
+
+		namespace Intl
+		{
+			/// Span recorded by a zone.
+			struct ZoneRecord
+			{
+				const char* name = nullptr;
+				uint64_t start = 0u;
+				uint64_t stop = 0u;
+			};
+
+			/// Single-producer / single-consumer ring of the zone records of one thread.
+			struct ZoneBuffer
+			{
+				static constexpr size_t capacity = SA_UTH_ZONE_CAPACITY;
+
+				ZoneRecord records[capacity];
+
+				/// Write index, owned by the recording thread.
+				std::atomic<size_t> head{ 0u };
+
+				/// Read index, owned by the flushing thread.
+				std::atomic<size_t> tail{ 0u };
+
+				/// Records dropped on full buffer.
+				std::atomic<uint64_t> dropped{ 0u };
+
+				/// Trace thread index of the recording thread.
+				unsigned int tid = 0u;
+
+				/// Push a record from the recording thread (dropped if full).
+				inline void Push(const ZoneRecord& _record) noexcept;
+			};
+
+			/// Registered buffers (kept alive after their thread exits).
+			inline std::vector<std::shared_ptr<ZoneBuffer>> zoneBuffers;
+			inline std::mutex zoneMutex;
+
+			/// Zone buffer of the current thread, registered on first use.
+			inline ZoneBuffer& LocalZoneBuffer();
+
+			/**
+			*	\brief Drain the zone buffers of every thread.
+			*
+			*	\param[in, out] _stats	Stats to merge records in (nullptr to only trace).
+			*
+			*	\return Number of records dropped since last flush.
+			*/
+			inline uint64_t FlushZones(std::vector<ZoneStats>* _stats);
+
+			/// Merge zone stats by name.
+			inline void MergeZoneStats(std::vector<ZoneStats>& _dst, const std::vector<ZoneStats>& _src);
 		}
 
+		/// \endcond
+
+//}
+
+
+//{ Title
+
+		struct Title
+		{
+			const std::string& funcDecl;
+			const std::string& fileName;
+			unsigned int lineNum = 0u;
+			bool pred = false;
+
+			/// Log test's title in console.
+			inline void Log() const;
+		};
+
+//}
+
+
+//{ Group
+
+		/// Resource limits of a group run in an isolated child process.
+		struct GroupLimits
+		{
+			/// Maximum address space of the process (in bytes, 0 == unlimited). Use RLIMIT_AS.
+			size_t memory = 0u;
+
+			/// Maximum CPU time (in seconds, 0 == unlimited). Use RLIMIT_CPU.
+			unsigned int cpuTime = 0u;
+		};
+
+		/// Failure of a group run in an isolated child process.
+		enum class LimitFailure
+		{
+			/// No failure.
+			None,
+
+			/// Memory limit exceeded (allocation failure).
+			Memory,
+
+			/// CPU time limit exceeded.
+			CpuTime,
+
+			/// Child process crashed or exited before the end of the group.
+			Crash,
+		};
+
+#ifndef SA_UTH_DFLT_SOFT_ASSERT
 		/**
-		*	\brief ToString implementation used to print tab of elems during unit testing.
-		*
-		*	Default implementation is for loop ToString(_elem).
-		*	Define template specialization for custom implementation.
-		*
-		*	\tparam T			Type of element.
-		*	\tparam size		Size of elem tab.
-		*	\param[in] _elems	Element to convert to string.
+		*	\brief Wether to defer failure output to the end of the group by default.
+		*	Can be defined within cmake options or before including the header.
+		*/
+		#define SA_UTH_DFLT_SOFT_ASSERT 0
+#endif
+
+		/**
+		*	\brief Dynamic soft assertion toogle.
 		*
-		*	\return	std::string from converted elements  using stringizer.
+		*	Failures run in a group only record their title and a snapshot of their params.
+		*	They are output, sorted by location, in a single report on group end (before group exit output).
+		*	Ignored with SA_UTH_EXIT_ON_FAILURE.
 		*/
-		template <typename T, unsigned int size>
-		std::string ToString(const T(&_elems)[size])
+		inline bool bSoftAssert = SA_UTH_DFLT_SOFT_ASSERT;
+
+
+		/// Infos generated from a group of tests.
+		class Group
 		{
-			std::string res = "{ ";
+			/// Running groups (group thread only): pushing and popping keep other groups in place.
+			static std::deque<Group> sGroups;
+
+			/// Top of sGroups, updated by worker threads running tests of the group.
+			static std::atomic<Group*> sTop;
+
+			/// Size of sGroups, read by worker threads (log indentation).
+			static std::atomic<size_t> sDepth;
+
+			/// Number of Update running on sTop: End waits for them before popping.
+			static std::atomic<unsigned int> sUpdating;
+
+		public:
+
+			/// Name of the group.
+			const std::string name;
+
+			/**
+			*	\brief Local exit from tests of the group.
+			*
+			*	UTH::localExit will be equal to EXIT_FAILURE (1) if at least one test of the group failed.
+			*
+			*	localExit 0 == success.
+			*	localExit 1 == failure.
+			*/
+			bool localExit = EXIT_SUCCESS;
+
+			/// Counter of test run in this group.
+			Counter count{};
+
+			/// Duration of the group (in nanoseconds), set on group end.
+			double time = 0.0;
+
+			/// Timer ticks at group begin.
+			uint64_t beginTicks = 0u;
+
+			/// Resource usage of the group: captured on group begin, delta set on group end.
+			Usage usage{};
+
+			/// Failure of the isolated run (group run with limits only).
+			LimitFailure limitFailure = LimitFailure::None;
+
+			/// Stats of the zones run in this group (and its children), set on group end.
+			std::vector<ZoneStats> zones{};
+
+			/// Index of the first soft failure recorded in this group.
+			size_t softFailureIndex = 0u;
+
+			/// Global Group counter.
+			static inline Counter globalCount;
+
+			/**
+			*	\brief Spreads values to parent group.
+			*
+			*	\param[in] _parent	parent to spread values to.
+			*/
+			inline void Spread(Group& _parent);
+
+			/**
+			*	\brief Update values from predicate.
+			*
+			*	\param[in] _pred	predicate from current test.
+			*/
+			static inline void Update(bool _pred);
+
+			/// Start a new group of tests.
+			static inline void Begin(const std::string& _name);
+
+			/// End a group of tests.
+			static inline Group End();
+
+			/// Whether a group of tests is running.
+			static inline bool IsRunning() noexcept;
+
+			/**
+			*	\brief Run a group of tests from a single body.
+			*
+			*	\param[in] _name	Name of the group.
+			*	\param[in] _body	Body running the tests.
+			*/
+			template <typename FuncT>
+			static void Run(const std::string& _name, FuncT&& _body);
+
+			/**
+			*	\brief Run a group of tests in an isolated child process under resource limits.
+			*
+			*	Exceeding a limit (or crashing) runs a failed test reporting the limit and the usage.
+			*	Limits are not supported on Windows (or when the child process can't be created): the group is run in-process.
+			*
+			*	\param[in] _name		Name of the group.
+			*	\param[in] _body		Body running the tests.
+			*	\param[in] _limits		Resource limits of the child process.
+			*	\param[in] _fileName	File name reported on limit failure.
+			*	\param[in] _lineNum	Line number reported on limit failure.
+			*/
+			template <typename FuncT>
+			static void Run(const std::string& _name, FuncT&& _body, const GroupLimits& _limits,
+				const std::string& _fileName = std::string(), unsigned int _lineNum = 0u);
+
+
+			/**
+			*	\brief GroupBegin output in console.
+			*
+			*	\param[in] _name	The name of the group that begins.
+			*/
+			static inline void BeginLog(const std::string& _name);
+
+			/**
+			*	\brief GroupEnd output in console.
+			*
+			*	\param[in] _group	The group that ends.
+			*/
+			static inline void EndLog(const UTH::Group& _group);
+
+
+			/// Warn about zone records dropped on full buffers.
+			static inline void LogZonesDropped(uint64_t _dropped);
+
+			static inline std::string TabStr() noexcept;
+
+			static inline void LogTabs() noexcept;
+		};
+
+		inline std::deque<Group> Group::sGroups;
+		inline std::atomic<Group*> Group::sTop{ nullptr };
+		inline std::atomic<size_t> Group::sDepth{ 0u };
+		inline std::atomic<unsigned int> Group::sUpdating{ 0u };
+
+//}
+
+
+//{ Param
+
+		/// Pair of param name and value.
+		struct Param
+		{
+			/// Param's name.
+			std::string name;
+
+			/// Param's value as a string.
+			std::string value;
+
+			/**
+			*	\brief Test parameters output in console.
+			*
+			*	\param[in] _params	Every param infos extracted from call.
+			*/
+			static inline void Log(const std::vector<Param>& _params);
+		};
+
+		/**
+		*	\brief Lazy view of a test parameter.
+		*
+		*	Refers to the tested value: only valid during the callback (unless created with Snapshot).
+		*	The value is converted to string only when ToString is called.
+		*/
+		class ParamView
+		{
+			const void* value = nullptr;
+			std::string (*toString)(const void* _value) = nullptr;
+			const char* (*typeName)() = nullptr;
+
+			/// Owned copy of the value (snapshot only).
+			std::shared_ptr<const void> storage;
+
+		public:
+			/// Param's name.
+			std::string name;
+
+			/**
+			*	\brief Create a view of _value.
+			*
+			*	\param[in] _name	Name of the param.
+			*	\param[in] _value	Value of the param.
+			*/
+			template <typename T>
+			static ParamView Make(std::string _name, const T& _value) noexcept;
+
+			/**
+			*	\brief Create a view owning a copy of _value, valid after the test.
+			*	Pointers are copied (not the pointed data), non-copyable values are converted to string immediately.
+			*
+			*	\param[in] _name	Name of the param.
+			*	\param[in] _value	Value of the param.
+			*/
+			template <typename T>
+			static ParamView Snapshot(std::string _name, const T& _value);
+
+			/// Name of the param's type (from compiler function signature).
+			inline const char* TypeName() const;
+
+			/// Convert param's value to string (UTH::ToString).
+			inline std::string ToString() const;
+		};
+
+		/// \cond Internal
+
+		namespace Intl
+		{
+			/// Readable name of type T (computed once per type).
+			template <typename T>
+			const char* TypeName();
+		}
+
+		/// \endcond
+
+//}
+
+
+//{ Optimizer
+
+		/**
+		*	\brief Prevent the compiler from optimizing away _value and its computation.
+		*
+		*	\tparam T			Type of value.
+		*	\param[in] _value	Value to keep alive.
+		*/
+		template <typename T>
+		inline void DoNotOptimize(const T& _value);
+
+		/**
+		*	\brief Prevent the compiler from optimizing away _value and its computation.
+		*	The value is also considered as modified.
+		*
+		*	\tparam T			Type of value.
+		*	\param[in] _value	Value to keep alive.
+		*/
+		template <typename T>
+		inline void DoNotOptimize(T& _value);
+
+		/// Force every pending memory write to be committed (compiler barrier).
+		inline void ClobberMemory();
+
+//}
+
+
+//{ Bench
+
+		/// Complexity models used to fit benchmark timings.
+		enum class Complexity
+		{
+			/// Constant: O(1).
+			O1,
+
+			/// Logarithmic: O(log n).
+			OLogN,
+
+			/// Linear: O(n).
+			ON,
+
+			/// Linearithmic: O(n log n).
+			ONLogN,
+
+			/// Quadratic: O(n^2).
+			ON2,
+		};
+
+		/// Benchmark environment controls.
+		struct BenchEnv
+		{
+			/// CPU index to pin the benchmark thread to (-1 == no pinning).
+			int cpu = -1;
+
+			/// Flush caches before each iteration (cold cache) by streaming a cacheSize buffer.
+			bool bColdCache = false;
+
+			/// Size of the buffer streamed to flush caches (in bytes).
+			size_t cacheSize = 32u * 1024u * 1024u;
+
+			/// Set flush-to-zero and denormals-are-zero floating-point modes.
+			bool bFlushDenormals = false;
+
+			/// Raise the thread scheduling priority (where allowed).
+			bool bHighPriority = false;
+
+			/// Active settings as a string.
+			inline std::string ToString() const;
+		};
+
+		/// Benchmark settings, read by every benchmark when it starts.
+		struct BenchSettings
+		{
+			/// Minimum time (in seconds) spent measuring one input size.
+			double minTime = 0.01;
+
+			/// Maximum wall time (in seconds) spent on one input size, overheads included (ex: cache flushes).
+			double maxTime = 1.0;
+
+			/// Requested environment controls.
+			BenchEnv env;
+
+
+			/**
+			*	\brief Adaptive mode: keep sampling until the confidence interval of the median converges.
+			*	Sampling also stops when maxTime or maxRuns is reached.
+			*/
+			bool bAdaptive = false;
+
+			/// Adaptive mode: target relative half-width of the 95% confidence interval of the median.
+			double targetCI = 0.01;
+
+			/// Adaptive mode: time (in seconds) of a single run.
+			double runTime = 0.001;
+
+			/// Adaptive mode: minimum number of runs.
+			unsigned int minRuns = 8u;
+
+			/// Adaptive mode: maximum number of runs.
+			unsigned int maxRuns = 10000u;
+
+
+			/// Compare: number of interleaved runs of each body.
+			unsigned int compareRuns = 30u;
+
+			/// Compare: significance level of the speedup test.
+			double compareAlpha = 0.01;
+		};
+
+		/// Current benchmark settings.
+		inline BenchSettings benchSettings;
+
+
+		/// State given to a benchmark body.
+		struct BenchState
+		{
+			/// Input size of the current run.
+			size_t n = 0u;
+
+			/// Items processed by one call of the body (default: n).
+			size_t items = 0u;
+
+			/// Bytes processed by one call of the body (default: 0).
+			size_t bytes = 0u;
+
+			/// Index of the thread running the body (scaling benchmark only).
+			unsigned int thread = 0u;
+
+			/// Number of threads running the body (scaling benchmark only).
+			unsigned int threadCount = 1u;
+		};
+
+		/// Measure of a benchmark for a single input size.
+		struct BenchSample
+		{
+			/// Input size.
+			size_t n = 0u;
+
+			/// Number of calls of the body per run.
+			unsigned int iterations = 0u;
+
+			/// Number of timed runs (1 unless in adaptive mode).
+			unsigned int runs = 1u;
+
+			/// Time of one call (in nanoseconds): mean of the run or median of the runs in adaptive mode.
+			double ns = 0.0;
+
+			/// Relative half-width of the 95% confidence interval of the median (adaptive mode only).
+			double ci = 0.0;
+
+			/// Throughput in items per second.
+			double itemsPerSec = 0.0;
+
+			/// Throughput in bytes per second.
+			double bytesPerSec = 0.0;
+		};
+
+		/// Infos generated from a benchmark.
+		class Bench
+		{
+		public:
+			/// Name of the benchmark.
+			const std::string name;
+
+			/// Measures for each input size.
+			std::vector<BenchSample> samples{};
+
+			/// Best fitted complexity.
+			Complexity complexity = Complexity::O1;
+
+			/// Coefficient of the fitted complexity (in nanoseconds).
+			double coef = 0.0;
+
+			/// Normalized root mean square error of the fit.
+			double rms = 0.0;
+
+			/// Environment controls actually applied during the run.
+			BenchEnv env{};
+
+			/// Fit samples' timings to every complexity model and keep the best one.
+			inline void Fit();
+
+			/**
+			*	\brief Run a body over a set of input sizes.
+			*
+			*	\tparam SizesT		Iterable type of input sizes.
+			*	\tparam FuncT		Body type: callable with (size_t) or (BenchState&).
+			*
+			*	\param[in] _name	Name of the benchmark.
+			*	\param[in] _sizes	Input sizes to run.
+			*	\param[in] _body	Body to measure.
+			*
+			*	\return Benchmark infos.
+			*/
+			template <typename SizesT, typename FuncT>
+			static Bench Range(const std::string& _name, const SizesT& _sizes, FuncT&& _body);
+
+			/**
+			*	\brief Benchmark output in console.
+			*
+			*	\param[in] _bench	The benchmark to output.
+			*/
+			static inline void Log(const Bench& _bench);
+		};
+
+		/// Infos generated from a benchmark comparison of two implementations.
+		class BenchCompare
+		{
+		public:
+			/// Name of the comparison.
+			const std::string name;
+
+			/// Measure of the baseline implementation (median of the runs).
+			BenchSample baseline{};
+
+			/// Measure of the candidate implementation (median of the runs).
+			BenchSample candidate{};
+
+			/// Minimum relative speedup required (ex: 0.1 == candidate at least 10% faster).
+			double minSpeedup = 0.0;
+
+			/// Measured relative speedup of the medians: baseline / candidate - 1.
+			double speedup = 0.0;
+
+			/// p-value of the test: candidate is at least minSpeedup faster.
+			double pValue = 1.0;
+
+			/// Significance level used for the test.
+			double alpha = 0.01;
+
+			/// Whether candidate is significantly at least minSpeedup faster.
+			inline bool IsFaster() const noexcept;
+
+			/**
+			*	\brief Compare a baseline and a candidate implementation.
+			*
+			*	Runs of both bodies are interleaved to cancel drift, then a one-sided
+			*	Mann-Whitney U test checks candidate is at least _minSpeedup faster.
+			*
+			*	\param[in] _name			Name of the comparison.
+			*	\param[in] _baseline		Baseline body callable with () or (BenchState&).
+			*	\param[in] _candidate		Candidate body callable with () or (BenchState&).
+			*	\param[in] _minSpeedup		Minimum relative speedup required.
+			*
+			*	\return Comparison infos.
+			*/
+			template <typename BaseT, typename CandT>
+			static BenchCompare Run(const std::string& _name, BaseT&& _baseline, CandT&& _candidate, double _minSpeedup = 0.0);
+
+			/**
+			*	\brief Benchmark comparison output in console.
+			*
+			*	\param[in] _compare	The comparison to output.
+			*/
+			static inline void Log(const BenchCompare& _compare);
+		};
+
+		/// Measure of a scaling benchmark for a single thread count.
+		struct BenchThreadSample
+		{
+			/// Number of threads running the body.
+			unsigned int threads = 1u;
+
+			/// Time of one call on each thread, from synchronized start to last thread end (in nanoseconds).
+			double ns = 0.0;
+
+			/// Aggregate throughput of every thread in items per second.
+			double itemsPerSec = 0.0;
+
+			/// Throughput relative to a single thread.
+			double speedup = 1.0;
+
+			/// Parallel efficiency: speedup / threads.
+			double efficiency = 1.0;
+		};
+
+		/// Infos generated from a multi-thread scaling benchmark.
+		class BenchScaling
+		{
+		public:
+			/// Name of the benchmark.
+			const std::string name;
+
+			/// Measures for each thread count (1, 2, 4, ... maxThreads).
+			std::vector<BenchThreadSample> samples{};
+
+			/// Minimum speedup required at the maximum thread count (0 == no check).
+			double minSpeedup = 0.0;
+
+			/// Whether the speedup at the maximum thread count reaches minSpeedup.
+			inline bool IsScaling() const noexcept;
+
+			/**
+			*	\brief Run a body on 1, 2, 4, ... _maxThreads threads with a synchronized start.
+			*
+			*	Every thread calls the body the same number of times (calibrated on a single thread).
+			*
+			*	\param[in] _name			Name of the benchmark.
+			*	\param[in] _maxThreads		Maximum number of threads.
+			*	\param[in] _body			Body callable with () or (BenchState&).
+			*	\param[in] _minSpeedup		Minimum speedup required at _maxThreads.
+			*
+			*	\return Scaling infos.
+			*/
+			template <typename FuncT>
+			static BenchScaling Run(const std::string& _name, unsigned int _maxThreads, FuncT&& _body, double _minSpeedup = 0.0);
+
+			/**
+			*	\brief Scaling benchmark output in console.
+			*
+			*	\param[in] _scaling	The benchmark to output.
+			*/
+			static inline void Log(const BenchScaling& _scaling);
+		};
+
+//}
+
+
+//{ Latency
+
+		/**
+		*	\brief HDR-style latency histogram.
+		*
+		*	Constant memory, log-linear buckets: values below 128 are exact, then every power of 2
+		*	is split in 64 buckets (relative precision 1/64).
+		*	Histograms recorded on several threads can be merged with operator+=.
+		*/
+		class Histogram
+		{
+			/// Number of linear sub-buckets (2^subBits).
+			static constexpr unsigned int subBits = 7u;
+
+			/// Number of exact values.
+			static constexpr size_t subCount = size_t(1u) << subBits;
+
+			/// Number of buckets per power of 2.
+			static constexpr size_t halfCount = subCount / 2u;
+
+			/// Total number of buckets covering the uint64 range.
+			static constexpr size_t bucketCount = (64u - subBits + 2u) * halfCount;
+
+			std::vector<uint64_t> counts;
+
+			uint64_t total = 0u;
+			uint64_t min = ~uint64_t(0u);
+			uint64_t max = 0u;
+			double sum = 0.0;
+
+			/// Bucket index of _value.
+			static inline size_t Index(uint64_t _value) noexcept;
+
+			/// Highest value stored in the bucket _index.
+			static inline uint64_t HighestValue(size_t _index) noexcept;
+
+		public:
+			inline Histogram();
+
+			/**
+			*	\brief Record a value.
+			*
+			*	\param[in] _value	Value to record (ex: latency in nanoseconds).
+			*/
+			inline void Record(uint64_t _value) noexcept;
+
+			/// Remove every recorded value.
+			inline void Reset() noexcept;
+
+			/// Number of recorded values.
+			inline uint64_t Count() const noexcept;
+
+			/// Lowest recorded value.
+			inline uint64_t Min() const noexcept;
+
+			/// Highest recorded value.
+			inline uint64_t Max() const noexcept;
+
+			/// Mean of recorded values.
+			inline double Mean() const noexcept;
+
+			/**
+			*	\brief Value at percentile.
+			*
+			*	\param[in] _percentile		Percentile in [0, 100] (ex: 99.9).
+			*
+			*	\return Highest value equivalent to the value at _percentile (within bucket precision).
+			*/
+			inline uint64_t Percentile(double _percentile) const noexcept;
+
+			/// Merge values recorded by _rhs.
+			inline Histogram& operator+=(const Histogram& _rhs) noexcept;
+		};
+
+
+		/// Percentile bound assertion (ex: P99 < 50us).
+		struct PercentileBound
+		{
+			/// Percentile in [0, 100].
+			double percentile = 0.0;
+
+			/// Exclusive upper bound of the value at percentile (in nanoseconds).
+			uint64_t bound = 0u;
+		};
+
+		/// Percentile selector used to build a PercentileBound.
+		struct PercentileTag
+		{
+			/// Percentile in [0, 100].
+			double percentile = 0.0;
+
+			/**
+			*	\brief Build a percentile bound.
+			*
+			*	\param[in] _bound	Exclusive upper bound of the value at percentile.
+			*
+			*	\return Percentile bound assertion.
+			*/
+			template <typename Rep, typename Period>
+			constexpr PercentileBound operator<(const std::chrono::duration<Rep, Period>& _bound) const noexcept
+			{
+				return PercentileBound{ percentile, static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(_bound).count()) };
+			}
+		};
+
+		/// Percentile selector helper (ex: P(99.99) < 1ms).
+		constexpr PercentileTag P(double _percentile) noexcept { return PercentileTag{ _percentile }; }
+
+		/// Median selector.
+		inline constexpr PercentileTag P50{ 50.0 };
+
+		/// 90th percentile selector.
+		inline constexpr PercentileTag P90{ 90.0 };
+
+		/// 99th percentile selector.
+		inline constexpr PercentileTag P99{ 99.0 };
+
+		/// 99.9th percentile selector.
+		inline constexpr PercentileTag P999{ 99.9 };
+
+
+		/// Infos generated from a latency recording.
+		class Latency
+		{
+		public:
+			/// Name of the recording.
+			const std::string name;
+
+			/// Latency of every operation (in nanoseconds).
+			Histogram histogram{};
+
+			/**
+			*	\brief Record the latency of _count calls of an operation.
+			*
+			*	\param[in] _name	Name of the recording.
+			*	\param[in] _op		Operation callable with (), (size_t index) or (BenchState&).
+			*	\param[in] _count	Number of calls to record.
+			*
+			*	\return Latency infos.
+			*/
+			template <typename FuncT>
+			static Latency Run(const std::string& _name, FuncT&& _op, size_t _count);
+
+			/**
+			*	\brief Latency output in console.
+			*
+			*	\param[in] _latency	The latency recording to output.
+			*/
+			static inline void Log(const Latency& _latency);
+		};
+
+//}
+
+
+//{ Profiler
+
+#ifndef SA_UTH_DFLT_PROFILE
+		/**
+		*	\brief Wether to start the sampling profiler on init by default.
+		*	Can be defined within cmake options or before including the header.
+		*/
+		#define SA_UTH_DFLT_PROFILE 0
+#endif
+
+		/**
+		*	\brief Sampling profiler attributing call stacks to the active group.
+		*
+		*	A SIGPROF timer on process CPU time captures raw stacks with backtrace() into a preallocated buffer.
+		*	Samples are symbolized on exit and written as folded stacks (flamegraph.pl, speedscope)
+		*	in Logs/profile_UTH-<date>.folded, rooted at the group path.
+		*	Link with -rdynamic (CMake ENABLE_EXPORTS) to resolve static symbols.
+		*	Not supported on Windows.
+		*/
+		class Profiler
+		{
+		public:
+			/// Maximum captured frames per sample.
+			static constexpr unsigned int maxFrames = 48u;
+
+			/// Preallocated sample count (further samples are dropped).
+			static constexpr size_t capacity = 16384u;
+
+			/**
+			*	\brief Start sampling.
+			*
+			*	\param[in] _frequency	Samples per second of CPU time.
+			*
+			*	\return true on success.
+			*/
+			static inline bool Start(unsigned int _frequency = 1000u);
+
+			/// Stop sampling (samples are kept until written).
+			static inline void Stop();
+
+			/// Whether sampling is running.
+			static inline bool IsRunning() noexcept;
+
+			/**
+			*	\brief Symbolize samples and write folded stacks. Called on exit.
+			*
+			*	\return Name of the written file (empty if no sample).
+			*/
+			static inline std::string Write();
+		};
+
+		/// \cond Internal
+
+		namespace Intl
+		{
+			/// Raw call stack sample.
+			struct ProfileSample
+			{
+				/// Index of the group path.
+				uint32_t group = 0u;
+
+				/// Number of captured frames.
+				int depth = 0;
+
+				void* frames[Profiler::maxFrames];
+			};
+
+			/// Profiler state, accessed from the signal handler.
+			struct ProfileState
+			{
+				std::unique_ptr<ProfileSample[]> samples;
+
+				/// Number of taken samples (may exceed capacity: dropped samples).
+				std::atomic<size_t> count{ 0u };
+
+				/// Index of the active group path.
+				std::atomic<uint32_t> group{ 0u };
+
+				/// Group paths (folded format), index 0 for samples outside of any group.
+				std::vector<std::string> groups{ std::string("[no group]") };
+
+				/// Group path indices of the group stack.
+				std::vector<uint32_t> groupStack;
+
+				bool bRunning = false;
+
+			#if SA_UTH_BACKTRACE
+				struct sigaction oldAction{};
+
+			#if __linux__
+				timer_t timer{};
+			#endif
+			#endif
+			};
+
+			inline ProfileState profileState;
+
+			/// Tag next samples with group _name, child of the active group (called on group begin).
+			inline void ProfileGroupBegin(const std::string& _name);
+
+			/// Tag next samples with the parent group (called on group end).
+			inline void ProfileGroupEnd();
+
+			/// Demangled symbol name of a return address.
+			inline std::string SymbolName(void* _address);
+		}
+
+		/// \endcond
+
+//}
+
+
+//{ Stats
+
+#ifndef SA_UTH_DFLT_STATS_PAGE
+		/**
+		*	\brief Wether to open the live stats page on init by default.
+		*	Can be defined within cmake options or before including the header.
+		*/
+		#define SA_UTH_DFLT_STATS_PAGE 0
+#endif
+
+		/**
+		*	\brief Live stats page (memory-mapped file) for external monitoring.
+		*
+		*	Default location: /dev/shm/sa_uth-<pid> if available, Logs/stats_UTH-<pid>.shm otherwise.
+		*	Attach with uth-top. The file is removed on close (attached readers keep the final values).
+		*	Pages of processes that died without close are removed on the next open (see StatsFile).
+		*	Page layout: StatsData (UnitTestHelperStats.hpp).
+		*	Not supported on Windows.
+		*/
+		class StatsPage
+		{
+		public:
+			/**
+			*	\brief Create and map the stats page.
+			*
+			*	\param[in] _path	Path of the mapped file (empty == default location).
+			*
+			*	\return true on success.
+			*/
+			static inline bool Open(const std::string& _path = std::string());
+
+			/// Mark the page as exited, unmap and remove it. Called on exit (no thread may still run tests).
+			static inline void Close();
+
+			/// Whether the stats page is open.
+			static inline bool IsOpen() noexcept;
+
+			/// Path of the mapped file.
+			static inline const std::string& Path() noexcept;
+		};
+
+		/// \cond Internal
+
+		namespace Intl
+		{
+			/// Mapped stats page (nullptr == closed).
+			inline StatsData* statsData = nullptr;
+
+			inline std::string statsPath;
+
+			/// Update counters of the current thread from test result _pred.
+			inline void StatsRecord(bool _pred) noexcept;
+
+			/// Update group path and group counters (called by the group thread).
+			inline void StatsGroup();
+		}
+
+		/// \endcond
+
+//}
+
+
+//{ Progress
+
+#ifndef SA_UTH_DFLT_PROGRESS
+		/**
+		*	\brief Wether to draw the console progress line on init by default (disabled if stdout is not a TTY).
+		*	Can be defined within cmake options or before including the header.
+		*/
+		#define SA_UTH_DFLT_PROGRESS 0
+#endif
+
+		/**
+		*	\brief Single-line console progress: groups done/total, assertions/s, failures and ETA.
+		*
+		*	Redrawn by a timer thread (at most every period), never per assertion.
+		*	std::cout is wrapped while running: any console output erases the line first.
+		*	Total and ETA use the top-level group durations of the previous run of the same executable
+		*	(Logs/progress_UTH-<executable>.txt), matched by group name.
+		*/
+		class Progress
+		{
+		public:
+			/// Redraw period (in milliseconds).
+			static constexpr unsigned int period = 100u;
+
+			/**
+			*	\brief Start the progress line.
+			*
+			*	\return false if stdout is not a TTY.
+			*/
+			static inline bool Start();
+
+			/// Erase the line, stop the timer and save group durations. Called on exit.
+			static inline void Stop();
+
+			/// Whether the progress line is running.
+			static inline bool IsRunning() noexcept;
+		};
+
+		/// \cond Internal
+
+		namespace Intl
+		{
+			/// std::cout buffer erasing the progress line before any output.
+			class ProgressBuf : public std::streambuf
+			{
+			public:
+				/// Wrapped std::cout buffer.
+				std::streambuf* out = nullptr;
+
+			protected:
+				inline int overflow(int _c) override;
+				inline std::streamsize xsputn(const char* _str, std::streamsize _size) override;
+				inline int sync() override;
+			};
+
+			/// Duration of a top-level group.
+			struct ProgressEntry
+			{
+				std::string name;
+
+				/// Duration (in nanoseconds).
+				double time = 0.0;
+			};
+
+			/// Progress line state.
+			struct ProgressState
+			{
+				std::atomic<bool> bRunning{ false };
+
+				/// Mirror of globalCount (written by test threads, read by the timer).
+				std::atomic<uint64_t> success{ 0u };
+				std::atomic<uint64_t> failure{ 0u };
+
+				/// Guard console output and members below.
+				std::mutex mutex;
+				std::condition_variable cv;
+				std::thread timer;
+				bool bStop = false;
+
+				/// Drawing suspended (process isolated group running).
+				bool bPaused = false;
+
+				/// Console cursor at line start: the line can be drawn.
+				bool bLineStart = true;
+
+				/// Size of the drawn line (0 == not drawn).
+				size_t drawnSize = 0u;
+
+				ProgressBuf buffer;
+
+				/// Top-level group durations of the previous run.
+				std::vector<ProgressEntry> history;
+
+				/// Whether history entries were matched by a group of this run.
+				std::vector<bool> historyDone;
+
+				/// Top-level group durations of this run.
+				std::vector<ProgressEntry> durations;
+
+				/// Durations of the matched groups in the previous run and this run (in nanoseconds).
+				double matchedHistory = 0.0;
+				double matchedActual = 0.0;
+
+				/// Begin of the running top-level group (0 == none).
+				uint64_t groupBeginTicks = 0u;
+
+				/// History entry of the running top-level group (-1 == none).
+				size_t groupHistory = static_cast<size_t>(-1);
+
+				/// Assertion rate, sampled every half second.
+				double rate = 0.0;
+				uint64_t rateTests = 0u;
+				std::chrono::steady_clock::time_point rateTime;
+			};
+
+			inline ProgressState progress;
+
+			/// File of the top-level group durations, keyed by executable name.
+			inline std::string ProgressHistoryFile();
+
+			/// First history entry named _name not matched yet (-1 == none).
+			inline size_t ProgressFindHistory(const std::string& _name);
+
+			/// Update counters from globalCount.
+			inline void ProgressRecord() noexcept;
+
+			/**
+			*	\brief Begin or end of a top-level group.
+			*
+			*	\param[in] _bBegin	Whether the group begins.
+			*	\param[in] _name		Name of the group.
+			*	\param[in] _time		Group duration on end (in nanoseconds).
+			*/
+			inline void ProgressGroup(bool _bBegin, const std::string& _name, double _time = 0.0);
+
+			/// Erase and suspend the line while a child process outputs.
+			inline void ProgressPause(bool _bPause);
+
+			/// Restore std::cout in a forked child (the timer thread does not exist there: no lock).
+			inline void ProgressDetach() noexcept;
+
+			/// Erase the drawn line (progress mutex locked).
+			inline void ProgressErase();
+
+			/// Draw the line (progress mutex locked).
+			inline void ProgressDraw();
+
+			/// Format the line (progress mutex locked).
+			inline std::string ProgressLine();
+		}
+
+		/// \endcond
+
+//}
+
+
+//{ Callback
+
+		/// Pointer to allow user to get custom data in callbacks.
+		inline void* UserData = nullptr;
+
+		/**
+		*	\brief Helper get user data with type.
+		*
+		*	\tparam T	The type to cast user data.
+		*
+		*	\return User data casted as T.
+		*/
+		template<typename T>
+		inline T& GetUserData() { return *reinterpret_cast<T*>(UserData); }
+
+		/// Callback called on groupe begin.
+		inline void (*GroupBeginCB)(const std::string& _name) = nullptr;
+
+		/// Callback called on groupe end.
+		inline void (*GroupEndCB)(const Group& _group) = nullptr;
+
+		/// Callback called on test's title processing.
+		inline void (*TitleCB)(const Title& _infos) = nullptr;
+
+		/// Callback called on test's parameters processing.
+		inline void (*ParamsCB)(const std::vector<Param>& _params) = nullptr;
+
+		/// Callback called on test's parameters processing, with lazy stringification.
+		inline void (*ParamViewsCB)(const std::vector<ParamView>& _params) = nullptr;
+
+		/// Callback called on test's result processing.
+		inline void (*ResultCB)(bool _pred) = nullptr;
+
+		/// Callback called on benchmark end.
+		inline void (*BenchCB)(const Bench& _bench) = nullptr;
+
+
+		/**
+		*	\brief Location and description of a test in the sources.
+		*
+		*	A constant instance per macro call site (static storage, no registration).
+		*/
+		struct TestSite
+		{
+			/// Source file path (__FILE__).
+			const char* filePath = nullptr;
+
+			unsigned int lineNum = 0u;
+
+			/// Title of the test (Title::funcDecl).
+			const char* funcDecl = "";
+
+			/// Params' names, separated by ", ".
+			const char* paramNames = "";
+
+			/// Source file name, without directories.
+			inline const char* FileName() const noexcept;
+		};
+
+		/// Compact result of a test for batched processing.
+		struct ResultRecord
+		{
+			/// Site of the test.
+			const TestSite* site = nullptr;
+
+			/// Index of the thread running the test.
+			uint32_t thread = 0u;
+
+			/// Time of the test since init (or since the first timestamp without init), in nanoseconds.
+			uint64_t timestamp = 0u;
+
+			/// Test result.
+			bool pred = false;
+		};
+
+		/**
+		*	\brief Callback called with batches of results.
+		*
+		*	Called every resultBatchSize results of a thread and on group end, without title or params computation.
+		*	Can be called from any thread running tests.
+		*/
+		inline void (*ResultBatchCB)(const ResultRecord* _records, size_t _count) = nullptr;
+
+		/// Number of results of a thread per ResultBatchCB call.
+		inline size_t resultBatchSize = 1024u;
+
+		/// \cond Internal
+
+		namespace Intl
+		{
+			/// Results of a single thread, waiting for ResultBatchCB.
+			struct ResultBuffer
+			{
+				std::mutex mutex;
+				std::vector<ResultRecord> records;
+			};
+
+			inline std::vector<std::shared_ptr<ResultBuffer>> resultBuffers;
+			inline std::mutex resultBuffersMutex;
+
+			/// Push result record in the current thread buffer.
+			inline void RecordResult(bool _pred, const TestSite& _site);
+
+			/// Send every buffered result to ResultBatchCB.
+			inline void FlushResults();
+		}
+
+		/// \endcond
+
+
+		/// Listener event flags.
+		namespace Event
+		{
+			enum : unsigned int
+			{
+				/// No event.
+				None,
+
+				/// Listener::OnGroupBegin.
+				GroupBegin = 1 << 0,
+
+				/// Listener::OnGroupEnd.
+				GroupEnd = 1 << 1,
+
+				/// Listener::OnTitle.
+				Title = 1 << 2,
+
+				/// Listener::OnParams.
+				Params = 1 << 3,
+
+				/// Listener::OnParamViews.
+				ParamViews = 1 << 4,
+
+				/// Listener::OnResult.
+				Result = 1 << 5,
+
+				/// Listener::OnBench.
+				Bench = 1 << 6,
+
+				/// Every event.
+				All = 0x7F
+			};
+		}
+
+		/**
+		*	\brief Test event subscriber.
+		*
+		*	Derive and override handlers of subscribed events: listener state is stored as members of the derived type.
+		*	Multiple listeners can be registered with AddListener, each with its own event mask.
+		*	Single-subscriber callbacks (GroupBeginCB, TitleCB, ...) are still called, before listeners.
+		*/
+		class Listener
+		{
+		public:
+			virtual ~Listener() = default;
+
+			/// Called on group begin.
+			virtual void OnGroupBegin(const std::string& _name) { (void)_name; }
+
+			/// Called on group end.
+			virtual void OnGroupEnd(const Group& _group) { (void)_group; }
+
+			/// Called on test's title processing.
+			virtual void OnTitle(const Title& _infos) { (void)_infos; }
+
+			/// Called on test's parameters processing.
+			virtual void OnParams(const std::vector<Param>& _params) { (void)_params; }
+
+			/// Called on test's parameters processing, with lazy stringification.
+			virtual void OnParamViews(const std::vector<ParamView>& _params) { (void)_params; }
+
+			/// Called on test's result processing.
+			virtual void OnResult(bool _pred) { (void)_pred; }
+
+			/// Called on benchmark end.
+			virtual void OnBench(const Bench& _bench) { (void)_bench; }
+		};
+
+		/**
+		*	\brief Register a listener.
+		*
+		*	Registering an already registered listener updates its event mask.
+		*	Listeners must be (un)registered while no test is running.
+		*
+		*	\param[in] _listener	Listener to register. Not owned: must outlive its registration.
+		*	\param[in] _events		Event flags to dispatch to this listener.
+		*/
+		inline void AddListener(Listener& _listener, unsigned int _events = Event::All);
+
+		/// Unregister a listener.
+		inline void RemoveListener(Listener& _listener);
+
+		/// \cond Internal
+
+		namespace Intl
+		{
+			/// Registered listener with its event mask.
+			struct ListenerEntry
+			{
+				Listener* listener = nullptr;
+				unsigned int events = Event::None;
+			};
+
+			inline std::vector<ListenerEntry> listeners;
+
+			/// Union of every registered listener event mask.
+			inline unsigned int listenerEvents = Event::None;
+
+			/// Whether any listener subscribed to _event.
+			inline bool HasListener(unsigned int _event) noexcept { return listenerEvents & _event; }
+
+			/**
+			*	\brief Call _func on every listener subscribed to _event.
+			*
+			*	\param[in] _event	Event flag.
+			*	\param[in] _func	Dispatch function taking a Listener&.
+			*/
+			template <typename FuncT>
+			inline void Notify(unsigned int _event, FuncT&& _func);
+		}
+
+		/// \endcond
+
+//}
+
+
+//{ ToString
+
+		namespace Intl
+		{
+			/**
+			*	Compile time check type T has member ToString using SFINAE.
+			* 
+			*	Source: https://github.com/SapphireSuite/Core/blob/main/Include/Core/Misc/HasMember.hpp
+			*
+			*/
+			template <typename T>
+			class HM_ToString
+			{
+				/// SFINAE success type.
+				using Yes = char;
+
+				/// SFINAE failure type.
+				using No = char[2];
+
+				/// template deduction helper.
+				template<typename C, C> struct CheckT;
+
+				/// Introduce Name member.
+				struct Fallback
+				{
+					/// Dummy variable with name Name for SFINAE deduction.
+					int ToString;
+				};
+
+				/// Merge T and Fallback members.
+				struct Derived : T, Fallback { };
+
+				template<typename C, C> struct ChT;
+
+				template <typename C>
+				static Yes& SFINAE(ChT<int Fallback::*, &C::ToString>* _c);
+
+				template <typename C>
+				static No& SFINAE(...);
+
+			public:
+				/// true if T as a public member called Name (ie: SFINAE failure), otherwise false.
+				static constexpr bool value = sizeof(SFINAE<Derived>(0)) == sizeof(No);
+			};
+		}
+
+		/**
+		*	\brief ToString implementation used to print elem during unit testing.
+		*
+		*	Default implementation: helper to call Stringizer using template deduction.
+		*	Define template specialization for simple class custom implementation.
+		* 
+		*	\tparam T			Type of element.
+		*	\param[in] _elem	Element to convert to string.
+		*
+		*	\return	std::string from converted element using stringizer.
+		*/
+		template <typename T>
+		std::string ToString(const T& _elem)
+		{
+			if constexpr (std::is_arithmetic<T>::value)
+				return std::to_string(_elem);
+			else if constexpr (std::is_enum<T>::value)
+				return std::to_string(static_cast<unsigned int>(_elem));
+			else if constexpr (std::is_pointer<T>::value)
+				return "0x" + std::to_string(reinterpret_cast<unsigned long long>(_elem));
+			else if constexpr (Intl::HM_ToString<T>::value)
+				return _elem.ToString();
+			else if constexpr (std::is_same<T, std::string>::value)
+				return _elem;
+			else
+			{
+#if SA_CORE_IMPL
+				return Sa::ToString(_elem);
+#else
+				return std::string();
+#endif
+			}
+		}
+
+		/**
+		*	\brief ToString implementation used to print tab of elems during unit testing.
+		*
+		*	Default implementation is for loop ToString(_elem).
+		*	Define template specialization for custom implementation.
+		*
+		*	\tparam T			Type of element.
+		*	\tparam size		Size of elem tab.
+		*	\param[in] _elems	Element to convert to string.
+		*
+		*	\return	std::string from converted elements  using stringizer.
+		*/
+		template <typename T, unsigned int size>
+		std::string ToString(const T(&_elems)[size])
+		{
+			std::string res = "{ ";
+
+			for (unsigned int i = 0; i < size; ++i)
+				res += ToString(_elems[i]) + "; ";
+
+			res[res.size() - 2] = ' ';
+			res[res.size() - 1] = '}';
+
+			return res;
+		}
+
+//}
+
+
+//{ Equals
+
+		/**
+		*	\brief Helper Equals function.
+		*
+		*	\tparam T		Type of operands.
+		*
+		*	\param[in] _lhs		Left hand side operand to compare.
+		*	\param[in] _rhs		Right hand side operand to compare.
+		*
+		*	\return	True on equality, otherwise false.
+		*/
+		template <typename T>
+		bool Equals(const T& _lhs, const T& _rhs)
+		{
+			return _lhs == _rhs;
+		}
+
+		/**
+		*	\brief Helper Equals function using epsilon.
+		*
+		*	\tparam T		Type of operands.
+		*
+		*	\param[in] _lhs		Left hand side operand to compare.
+		*	\param[in] _rhs		Right hand side operand to compare.
+		*	\param[in] _epsilon	Epsilon value for threshold compare.
+		*
+		*	\return	True on equality, otherwise false.
+		*/
+		template <typename T>
+		bool Equals(const T& _lhs, const T& _rhs, const T& _epsilon)
+		{
+			return std::abs(_lhs - _rhs) < _epsilon;
+		}
+
+		/**
+		*	\brief Helper Equals function for tab.
+		*
+		*	\tparam T		Type of operands.
+		*
+		*	\param[in] _lhs		Left hand side operand to compare.
+		*	\param[in] _rhs		Right hand side operand to compare.
+		*	\param[in] _size	Size of tabs to compare compare.
+		*
+		*	\return	True on equality, otherwise false.
+		*/
+		template <typename T>
+		bool Equals(const T* _lhs, const T* _rhs, unsigned int _size)
+		{
+			for (unsigned int i = 0; i < _size; ++i)
+			{
+				if (!Equals(_lhs[i], _rhs[i]))
+					return false;
+			}
+
+			return true;
+		}
+
+		/**
+		*	\brief Helper Equals function for tab using epsilon.
+		*
+		*	\tparam T		Type of operands.
+		*
+		*	\param[in] _lhs		Left hand side operand to compare.
+		*	\param[in] _rhs		Right hand side operand to compare.
+		*	\param[in] _size	Size of tabs to compare compare.
+		*	\param[in] _epsilon	Epsilon value for threshold compare.
+		*
+		*	\return	True on equality, otherwise false.
+		*/
+		template <typename T>
+		bool Equals(const T* _lhs, const T* _rhs, unsigned int _size, const T& _epsilon)
+		{
+			for (unsigned int i = 0; i < _size; ++i)
+			{
+				if (!Equals(_lhs[i], _rhs[i], _epsilon))
+					return false;
+			}
+
+			return true;
+		}
+
+//}
+
+
+//{ Random
+
+		/**
+		*	\brief Rand between [min, max[ (max excluded).
+		*
+		*	\tparam T			Type of the rand.
+		*	\param[in] _min		Min bound for rand (included).
+		*	\param[in] _max		Max bound for rand (excluded).
+		*
+		*	\return Random T between [min, max[ (max excluded).
+		*/
+		template <typename T>
+		T Rand(T _min = T(0), T _max = T(1))
+		{
+			return _min + static_cast<T>(rand()) / static_cast<T>(RAND_MAX / (_max - _min));
+		}
+
+		/**
+		*	\brief Rand specialization for bool.
+		*
+		*	\param[in] _min		Min bound (false) (included).
+		*	\param[in] _max		Max bound (true) (included).
+		*
+		*	\return Random bool.
+		*/
+		template<>
+		inline bool Rand(bool _min, bool _max) { (void)_min; (void)_max; return Rand<int>(0, 2) == 1; }
+
+//}
+
+
+//{ Compute
+
+		/// \cond Internal
+
+		namespace Intl
+		{
+			/// Total number of test run.
+			inline Counter globalCount;
+
+			/// Guard failure states set by threads running tests (Group::localExit, UTH::exit).
+			inline std::mutex failureMutex;
+
+			/// Update UTH module from predicate.
+			inline void Update(bool _pred);
+
+			/// Update UTH module from predicate of test site _site.
+			inline void Update(bool _pred, const TestSite& _site);
+			
+
+			/// Compute title from function declaration and line num (not inlined: frame skipped by failure stacks).
+			inline void ComputeTitle(const Title& _infos);
+
+			/// Compute title of macro test _site, only built when output (not inlined: frame skipped by failure stacks).
+			inline void ComputeTitle(const TestSite& _site, bool _pred);
+
+			/// Output title to logs, callbacks and listeners.
+			inline void OutputTitle(const Title& _infos);
+
+			/// Add failed test _infos to the trace.
+			inline void TraceFailure(const Title& _infos);
+
+
+			/// Failed test with raw call stack (symbolized on exit).
+			struct FailureRecord
+			{
+				std::string funcDecl;
+				std::string fileName;
+				unsigned int lineNum = 0u;
+
+				/// Raw return addresses, innermost first.
+				std::vector<void*> stack{};
+			};
+
+			/// Failures recorded with a call stack.
+			inline std::vector<FailureRecord> failureRecords;
+
+			/// Guard failureRecords and failureRecordsDropped (failures from worker threads).
+			inline std::mutex failureRecordsMutex;
+
+			/// Maximum number of recorded failure stacks (next ones are counted only).
+			constexpr size_t maxFailureRecords = 256u;
+
+			/// Failures not recorded (maxFailureRecords reached).
+			inline size_t failureRecordsDropped = 0u;
+
+			/**
+			*	\brief Capture raw call stack of the failed test _infos (no symbol lookup).
+			*	Must be called from ComputeTitle: both frames are skipped.
+			*/
+			inline void CaptureFailureStack(const Title& _infos);
+
+			/// Symbolize and output recorded failure stacks, then clear them.
+			inline void LogFailureStacks();
+
+
+			/// Compute params.
+			template <typename... Args>
+			void ComputeParam(bool _pred, std::string _paramNames, const Args&... _args);
+
+			/// Compute params of macro test _site (names only split when output).
+			template <typename... Args>
+			void ComputeParam(const TestSite& _site, bool _pred, const Args&... _args);
+
+			/// Whether params of a test with predicate _pred are output.
+			inline bool ShouldComputeParams(bool _pred);
+
+			/// Set names of _views from params' names, separated by ", ".
+			inline void NameParams(std::vector<ParamView>& _views, const char* _paramNames);
+
+			/// Output generated params to logs, callbacks and listeners.
+			inline void ComputeParamViews(bool _pred, const std::vector<ParamView>& _views);
+
+			/**
+			*	\brief Generate ParamViews from params' names and values.
+			*
+			*	\param[out] _result		Generated views.
+			*	\param[in] _bSnapshot		Whether views own a copy of the values (see ParamView::Snapshot).
+			*	\param[in] _paramNames	Params' names, separated by ", ".
+			*/
+			template <typename FirstT, typename... Args>
+			void GenerateParamViews(std::vector<ParamView>& _result, bool _bSnapshot, std::string _paramNames, const FirstT& _first, const Args&... _args);
+
+
+			/// Failed test recorded in soft assertion mode, output on group end.
+			struct SoftFailure
+			{
+				/// Site of a macro test (title built on report), nullptr otherwise.
+				const TestSite* site = nullptr;
+
+				/// Title infos of other tests (Title only refers to strings).
+				std::string funcDecl{};
+				std::string fileName{};
+				unsigned int lineNum = 0u;
+
+				/// Params snapshot (named on report for macro tests).
+				std::vector<ParamView> params{};
+			};
+
+			/// Soft failures of the running groups (sorted by group begin).
+			inline std::vector<SoftFailure> softFailures;
+			inline std::mutex softFailuresMutex;
+
+			/// Soft failure of the test being computed by this thread.
+			inline thread_local size_t softFailureCurrent = static_cast<size_t>(-1);
+
+			/// Whether this thread is outputting soft failures.
+			inline thread_local bool bSoftReport = false;
+
+			/// Whether failure _pred is recorded as a soft failure.
+			inline bool ShouldDefer(bool _pred);
+
+			/// Record soft failure of the test being computed by this thread.
+			inline void RecordSoftFailure(SoftFailure&& _failure);
+
+			/// Attach params snapshot to the soft failure of the test being computed by this thread.
+			inline void RecordSoftParams(std::vector<ParamView>&& _views);
+
+			/**
+			*	\brief Output soft failures recorded since _index, sorted by location, then remove them.
+			*
+			*	\param[in] _index	Index of the first soft failure of the ending group.
+			*/
+			inline void ReportSoftFailures(size_t _index);
+
+
+			/// Compute the result using _pred predicate.
+			inline void ComputeResult(bool _pred);
+
+			/// Wether to continue computing test with predicate _pred.
+			inline bool ShouldComputeTest(bool _pred);
+
+
+			/// Compute benchmark output and callback.
+			inline void ComputeBench(const Bench& _bench);
+
+			/// No complexity declared: nothing to check.
+			inline void CheckComplexity(const Bench& _bench, const std::string& _fileName, unsigned int _lineNum);
+
+			/// Check fitted complexity of _bench is not worse than _expected.
+			inline void CheckComplexity(const Bench& _bench, const std::string& _fileName, unsigned int _lineNum, Complexity _expected);
+
+			/// Check candidate of _compare is significantly faster than baseline.
+			inline void CheckSpeedup(const BenchCompare& _compare, const std::string& _fileName, unsigned int _lineNum);
+
+			/// Check speedup of _scaling at maximum thread count (if a minimum speedup is required).
+			inline void CheckScaling(const BenchScaling& _scaling, const std::string& _fileName, unsigned int _lineNum);
+
+			/// No percentile bound declared: nothing to check.
+			inline void CheckPercentiles(const Latency& _latency, const std::string& _fileName, unsigned int _lineNum);
+
+			/// Check every percentile bound of _latency (one test per bound).
+			template <typename... Args>
+			void CheckPercentiles(const Latency& _latency, const std::string& _fileName, unsigned int _lineNum,
+				const PercentileBound& _bound, const Args&... _bounds);
+
+			/**
+			*	\brief Run a failed test reporting an exceeded group limit.
+			*
+			*	\param[in] _group		Group run with limits.
+			*	\param[in] _limits		Limits of the group.
+			*	\param[in] _cpuTime	CPU time used by the child process (in seconds).
+			*	\param[in] _addressSpace	Peak address space of the child process (in bytes, 0 == unknown).
+			*	\param[in] _resident		Peak resident memory of the child process (in bytes), reported if address space is unknown.
+			*	\param[in] _status		Child process exit status.
+			*	\param[in] _fileName	File name of the group run.
+			*	\param[in] _lineNum	Line number of the group run.
+			*/
+			inline void ComputeLimitFailure(const Group& _group, const GroupLimits& _limits, double _cpuTime, size_t _addressSpace, size_t _resident, int _status,
+				const std::string& _fileName, unsigned int _lineNum);
+
+			/// Peak address space of the current process (in bytes, 0 == unknown). Read from /proc on Linux only.
+			inline size_t PeakAddressSpace() noexcept;
+
+			/// Format a percentile (ex: 99.9 -> "p99.9").
+			inline std::string FormatPercentile(double _percentile);
+
+			/// Index of the highest bit set in _value (_value must not be 0).
+			inline unsigned int HighestBit(uint64_t _value) noexcept;
+
+			/**
+			*	\brief Call a benchmark body once, keeping its result alive.
+			*
+			*	\param[in] _body	Body callable with (BenchState&), (size_t) or ().
+			*	\param[in] _state	State of the current run.
+			*/
+			template <typename FuncT>
+			void RunBenchBody(FuncT& _body, BenchState& _state);
+
+			/**
+			*	\brief Measure _iterations calls of a benchmark body.
+			*
+			*	\param[in] _body		Body callable with (size_t) or (BenchState&).
+			*	\param[in] _state		State of the current run.
+			*	\param[in] _iterations	Number of calls.
+			*	\param[in] _env		Active environment controls.
+			*
+			*	\return Total time of the calls (in nanoseconds), cache flushes excluded.
+			*/
+			template <typename FuncT>
+			double MeasureBenchBody(FuncT& _body, BenchState& _state, unsigned int _iterations, const BenchEnv& _env);
+
+			/**
+			*	\brief Measure a benchmark body for a single input size.
+			*	Use fixed or adaptive mode from benchSettings.
+			*
+			*	\param[in] _body		Body callable with (size_t) or (BenchState&).
+			*	\param[in] _state		State of the current run.
+			*	\param[in] _env		Active environment controls.
+			*
+			*	\return measure of the input size.
+			*/
+			template <typename FuncT>
+			BenchSample MeasureBenchSize(FuncT& _body, BenchState& _state, const BenchEnv& _env);
+
+			/**
+			*	\brief Find the number of calls of a benchmark body for a run to last _runTime.
+			*
+			*	\param[in] _body		Body callable with (BenchState&), (size_t) or ().
+			*	\param[in] _state		State of the current run.
+			*	\param[in] _env		Active environment controls.
+			*	\param[in] _runTime	Target time of a run (in seconds).
+			*	\param[out] _ns		Time of one call measured during the last run (in nanoseconds).
+			*
+			*	\return Number of calls per run.
+			*/
+			template <typename FuncT>
+			unsigned int CalibrateBenchBody(FuncT& _body, BenchState& _state, const BenchEnv& _env, double _runTime, double& _ns);
+
+			/**
+			*	\brief One-sided Mann-Whitney U test.
+			*	H1: values of _lhs are stochastically smaller than values of _rhs.
+			*
+			*	\param[in] _lhs	First set of values.
+			*	\param[in] _rhs	Second set of values.
+			*
+			*	\return p-value of the test (normal approximation).
+			*/
+			inline double MannWhitneyU(const std::vector<double>& _lhs, const std::vector<double>& _rhs);
+
+			/**
+			*	\brief Compute the median and its 95% confidence interval (distribution-free, from order statistics).
+			*
+			*	\param[in] _sorted		Sorted values.
+			*	\param[out] _median	Median of the values.
+			*
+			*	\return Relative half-width of the confidence interval.
+			*/
+			inline double MedianCI(const std::vector<double>& _sorted, double& _median);
+
+			/// Evict caches by streaming a buffer of _size bytes.
+			inline void FlushCache(size_t _size);
+
+			/// Apply benchmark environment controls for its lifetime.
+			class BenchEnvScope
+			{
+			#if _WIN32
+				DWORD_PTR prevAffinity = 0u;
+				int prevPriority = THREAD_PRIORITY_NORMAL;
+			#else
+			#if __linux__
+				cpu_set_t prevAffinity{};
+			#endif
+				int prevPriority = 0;
+			#endif
+
+			#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86) || defined(__aarch64__)
+				unsigned long long prevFPMode = 0u;
+			#endif
+
+				BenchEnv applied;
+
+			public:
+				/**
+				*	\brief Apply requested controls.
+				*
+				*	\param[in] _requested	Requested controls.
+				*/
+				inline BenchEnvScope(const BenchEnv& _requested);
+
+				/// Restore previous environment.
+				inline ~BenchEnvScope();
+
+				/// Controls actually applied.
+				inline const BenchEnv& Applied() const noexcept;
+			};
+
+			/// Format a duration in nanoseconds with the most readable unit.
+			inline std::string FormatDuration(double _ns);
+
+			/// Format a per-second rate with SI prefixes.
+			inline std::string FormatRate(double _rate, const char* _unit);
+		}
+
+		/// \endcond
+
+//}
+
+
+//}
+
+
+//{ Cpp
+
+		/// \cond
+
+//{ Init / Exit
+
+		namespace Intl
+		{
+			void Init()
+			{
+				using namespace Intl;
+
+				SetConsoleColor(CslColor::Init);
+
+				// Init rand.
+				time_t currTime = time(NULL);
+				srand(static_cast<unsigned int>(currTime));
+				SA_UTH_LOG("[SA-UTH] Init Rand seed: " << currTime);
+
+				// Calibrate timer at startup.
+				Timer::Calibrate();
+				OriginTicks(Timer::Start());
+				SA_UTH_LOG("[SA-UTH] Init Timer: " << (Timer::IsCycleCounter() ? "cpu counter" : "steady_clock") <<
+					" (overhead: " << FormatDuration(Timer::Overhead()) << ')');
+
+				if (SA_UTH_DFLT_PROFILE && Profiler::Start())
+					SA_UTH_LOG("[SA-UTH] Init Profiler: sampling started");
+
+				if (SA_UTH_DFLT_STATS_PAGE && StatsPage::Open())
+					SA_UTH_LOG("[SA-UTH] Init Stats page: " << StatsPage::Path());
+
+				if (SA_UTH_DFLT_PROGRESS && Progress::Start())
+					SA_UTH_LOG("[SA-UTH] Init Progress: redrawn every " << Progress::period << " ms");
+
+				SetConsoleColor(CslColor::None);
+			}
+
+			int Exit()
+			{
+				using namespace Intl;
+
+				FlushResults();
+
+				// Final output is not mixed with the progress line.
+				Progress::Stop();
+
+				// Pending logs of other threads.
+				ThreadLog::Merge();
+
+				// Write pending trace events.
+				FlushZones(nullptr);
+				Trace::instance.Flush();
+
+				Profiler::Stop();
+
+				// Monitors see the run as done.
+				StatsPage::Close();
+
+				// Reset to default.
+				bCslLog = SA_UTH_DFLT_CSL_LOG;
+				bFileLog = SA_UTH_DFLT_FILE_LOG;
+
+				// Logs following the last dumped failure.
+				if (bFlightRecorder && Sa::UTH::exit == EXIT_FAILURE)
+					FlightRecorder::Flush(true);
+
+				FlightRecorder::RestoreHandlers();
+
+				// Exit output is never recorded.
+				bFlightRecorder = false;
+
+				LogFailureStacks();
+
+				// Symbolize profile samples.
+				{
+					const size_t samples = profileState.count.load();
+					const std::string profileFile = Profiler::Write();
+
+					if (!profileFile.empty())
+					{
+						SetConsoleColor(CslColor::Exit);
+						SA_UTH_LOG("[SA-UTH] Profile: " << (std::min)(samples, Profiler::capacity) << " samples (" <<
+							(samples > Profiler::capacity ? samples - Profiler::capacity : 0u) << " dropped) written in " << profileFile);
+					}
+				}
+
+				SetConsoleColor(CslColor::Exit);
+				__SA_UTH_LOG_IN("[SA-UTH] Run: ");
+
+
+				Intl::globalCount.Log();
+
+				// Output Group counter.
+				if ((verbosity & Verbosity::GroupCount) && !Group::globalCount.IsEmpty())
+				{
+					SetConsoleColor(CslColor::Exit);
+					__SA_UTH_LOG_IN(" in ");
+
+					Group::globalCount.Log();
+
+					SetConsoleColor(CslColor::GroupEnd);
+					__SA_UTH_LOG_IN(" groups");
+				}
+
+
+				// Output exit.
+				SetConsoleColor(CslColor::Exit);
+				__SA_UTH_LOG_IN(" and exit with code: ");
+
+				if (exit == EXIT_SUCCESS)
+				{
+					SetConsoleColor(CslColor::Success);
+					__SA_UTH_LOG_IN("EXIT_SUCCESS (" << EXIT_SUCCESS << ')');
+				}
+				else
+				{
+					SetConsoleColor(CslColor::Failure);
+					__SA_UTH_LOG_IN("EXIT_FAILURE (" << EXIT_FAILURE << ')');
+				}
+
+				__SA_UTH_LOG_ENDL();
+				SetConsoleColor(CslColor::None);
+
+			#if SA_UTH_EXIT_PAUSE && !defined(SA_CI)
+				SA_UTH_LOG("[SA-UTH] Press Enter to continue...");
+				std::cin.get();
+			#endif
+
+				return exit;
+			}
+		}
+
+//}
+
+
+//{ Logger
+
+		namespace Intl
+		{
+			Logger::Logger()
+			{
+				// Open Log file.
+				{
+					std::filesystem::create_directories("Logs");
+
+					/**
+					*	log_UTH-<month>.<day>.<year>-<hour>h<minute>m<second>s.txt
+					*	Ex: 2/27/2021 at 12:07:43
+					*	log_UTH-2.27.2021-12h07m43s.txt
+					*/
+					logFileName = std::string("Logs/log_UTH-") + DateStr() + ".txt";
+
+					logFile.open(logFileName, std::ios::out | std::ios::app);
+				}
+			}
+
+			Logger::~Logger()
+			{
+				// Close log file.
+				logFile.close();
+			}
+
+
+			FlightRecorder::Ring& FlightRecorder::LocalRing()
+			{
+				thread_local const std::shared_ptr<Ring> ring = []()
+				{
+					std::shared_ptr<Ring> res = std::make_shared<Ring>();
+					res->tid = ThreadIndex();
+
+					std::lock_guard<std::mutex> lock(ringsMutex);
+
+					// Dump on crash: installed with the first ring.
+					if (rings.empty() && !bHandlersInstalled)
+					{
+						for (size_t i = 0u; i < sizeof(crashSignals) / sizeof(int); ++i)
+							previousHandlers[i] = std::signal(crashSignals[i], CrashHandler);
+
+						bHandlersInstalled = true;
+					}
+
+					rings.push_back(res);
+
+					return res;
+				}();
+
+				return *ring;
+			}
+
+			void FlightRecorder::Write(const std::string& _str)
+			{
+				Ring& ring = LocalRing();
+
+				std::lock_guard<std::mutex> lock(ring.mutex);
+
+				ring.line += _str;
+
+				if (ring.line.empty() || ring.line.back() != '\n')
+					return;
+
+				if (ring.records.size() != flightRecorderSize)
+				{
+					ring.records.resize(flightRecorderSize);
+					ring.next = 0u;
+				}
+
+				if (ring.records.empty())
+				{
+					ring.line.clear();
+					return;
+				}
+
+				Record& record = ring.records[ring.next];
+				record.text.swap(ring.line);
+				record.flag = logFlag;
+
+				ring.line.clear();
+				ring.next = (ring.next + 1u) % ring.records.size();
+			}
+
+			void FlightRecorder::DumpRing(Ring& _ring)
+			{
+				// Oldest record first.
+				for (size_t i = 0u; i < _ring.records.size(); ++i)
+				{
+					Record& record = _ring.records[(_ring.next + i) % _ring.records.size()];
+
+					if (record.text.empty())
+						continue;
+
+					LogFlagScope flagScope(record.flag);
+					LogWrite(record.text);
+
+					record.text.clear();
+				}
+
+				if (!_ring.line.empty())
+				{
+					LogWrite(_ring.line + '\n');
+					_ring.line.clear();
+				}
+
+				FlushSinks();
+			}
+
+			bool FlightRecorder::HasRecords(const Ring& _ring)
+			{
+				if (!_ring.line.empty())
+					return true;
+
+				for (auto it = _ring.records.begin(); it != _ring.records.end(); ++it)
+				{
+					if (!it->text.empty())
+						return true;
+				}
+
+				return false;
+			}
+
+			void FlightRecorder::Dump(bool _bAllThreads)
+			{
+				DirectLogScope directScope;
+
+				SetConsoleColor(CslColor::Failure);
+				SA_UTH_LOG("[SA-UTH] Flight recorder: last logs" << (_bAllThreads ? " of every thread" : ""));
+				SetConsoleColor(CslColor::None);
+
+				Flush(_bAllThreads);
+			}
+
+			void FlightRecorder::Flush(bool _bAllThreads)
+			{
+				// Write directly while flushing (other threads keep recording).
+				DirectLogScope directScope;
+
+				if (_bAllThreads)
+				{
+					std::lock_guard<std::mutex> lock(ringsMutex);
+
+					for (auto it = rings.begin(); it != rings.end(); ++it)
+					{
+						// Never wait: may be called from a crash handler.
+						std::unique_lock<std::mutex> ringLock((*it)->mutex, std::try_to_lock);
+
+						if (!ringLock.owns_lock() || !HasRecords(**it))
+							continue;
+
+						if (rings.size() > 1u)
+							SA_UTH_LOG("[SA-UTH] Thread " << (*it)->tid << ':');
+
+						DumpRing(**it);
+					}
+				}
+				else
+				{
+					Ring& ring = LocalRing();
+
+					std::lock_guard<std::mutex> lock(ring.mutex);
+					DumpRing(ring);
+				}
+			}
+
+			void FlightRecorder::RestoreHandlers()
+			{
+				if (!bHandlersInstalled)
+					return;
+
+				for (size_t i = 0u; i < sizeof(crashSignals) / sizeof(int); ++i)
+				{
+					if (previousHandlers[i] == SIG_ERR)
+						continue;
+
+					const SignalHandler current = std::signal(crashSignals[i], previousHandlers[i]);
+
+					// Keep a handler installed after ours.
+					if (current != CrashHandler)
+						std::signal(crashSignals[i], current);
+				}
+
+				bHandlersInstalled = false;
+			}
+
+			void FlightRecorder::CrashHandler(int _signal)
+			{
+				// Best effort: not async-signal-safe, the process is crashing anyway.
+				DirectLogScope directScope;
+
+				SetConsoleColor(CslColor::Failure);
+				SA_UTH_LOG("[SA-UTH] Crash: signal " << _signal);
+				SetConsoleColor(CslColor::None);
+
+				Dump(true);
+
+				SignalHandler previous = SIG_DFL;
+
+				for (size_t i = 0u; i < sizeof(crashSignals) / sizeof(int); ++i)
+				{
+					if (crashSignals[i] == _signal && previousHandlers[i] != SIG_ERR)
+						previous = previousHandlers[i];
+				}
+
+				// Chain: previous handler (or default action) on re-raise.
+				std::signal(_signal, previous);
+				std::raise(_signal);
+			}
+
+
+			uint64_t OriginTicks(uint64_t _ticks) noexcept
+			{
+				const uint64_t origin = originTicks.load(std::memory_order_relaxed);
+
+				if (origin)
+					return origin;
+
+				// First timestamp wins.
+				uint64_t expected = 0u;
+
+				return originTicks.compare_exchange_strong(expected, _ticks, std::memory_order_relaxed) ? _ticks : expected;
+			}
+
+
+			Trace::~Trace()
+			{
+				Flush();
+
+				if (bOpened)
+				{
+					traceFile << "\n]\n";
+					traceFile.close();
+				}
+			}
+
+			void Trace::Append(const std::string& _event)
+			{
+				if (!buffer.empty() || bOpened)
+					buffer += ",\n";
+
+				buffer += _event;
+
+				// Stream by chunks.
+				if (buffer.size() >= 64u * 1024u)
+					WriteBuffer();
+			}
+
+			void Trace::WriteBuffer()
+			{
+				if (buffer.empty())
+					return;
+
+				if (!bOpened)
+				{
+					std::filesystem::create_directories("Logs");
+
+					// trace_UTH-<month>.<day>.<year>-<hour>h<minute>m<second>s.json
+					traceFile.open(std::string("Logs/trace_UTH-") + DateStr() + ".json", std::ios::out | std::ios::trunc);
+					traceFile << "[\n";
+
+					bOpened = true;
+				}
+
+				traceFile << buffer;
+				traceFile.flush();
+
+				buffer.clear();
+			}
+
+			std::string Trace::EventHead(const std::string& _name, const char* _cat, char _phase, uint64_t _ticks, unsigned int _tid) const
+			{
+			#if _WIN32
+				const unsigned long pid = GetCurrentProcessId();
+			#else
+				const long pid = static_cast<long>(getpid());
+			#endif
+
+				const uint64_t origin = OriginTicks(_ticks);
+				const double ts = _ticks > origin ? Timer::ToNs(static_cast<double>(_ticks - origin)) / 1000.0 : 0.0;
+
+				std::ostringstream res;
+				res << std::fixed << std::setprecision(3) <<
+					"{\"name\":\"" << JsonEscape(_name) << "\",\"cat\":\"" << _cat << "\",\"ph\":\"" << _phase <<
+					"\",\"ts\":" << ts << ",\"pid\":" << pid << ",\"tid\":" << _tid;
+
+				return res.str();
+			}
+
+			void Trace::Begin(const std::string& _name, const char* _cat)
+			{
+				const std::string event = EventHead(_name, _cat, 'B', Timer::Start(), ThreadIndex()) + '}';
+
+				std::lock_guard<std::mutex> lock(mutex);
+				Append(event);
+			}
+
+			void Trace::End(const std::string& _name, const char* _cat)
+			{
+				const std::string event = EventHead(_name, _cat, 'E', Timer::Stop(), ThreadIndex()) + '}';
+
+				std::lock_guard<std::mutex> lock(mutex);
+				Append(event);
+			}
+
+			void Trace::Complete(const std::string& _name, const char* _cat, uint64_t _start, uint64_t _stop, const std::string& _args)
+			{
+				Complete(ThreadIndex(), _name, _cat, _start, _stop, _args);
+			}
+
+			void Trace::Complete(unsigned int _tid, const std::string& _name, const char* _cat, uint64_t _start, uint64_t _stop, const std::string& _args)
+			{
+				std::ostringstream event;
+				event << std::fixed << std::setprecision(3) << EventHead(_name, _cat, 'X', _start, _tid) <<
+					",\"dur\":" << (_stop > _start ? Timer::ToNs(static_cast<double>(_stop - _start)) / 1000.0 : 0.0);
+
+				if (!_args.empty())
+					event << ",\"args\":" << _args;
+
+				event << '}';
+
+				std::lock_guard<std::mutex> lock(mutex);
+				Append(event.str());
+			}
+
+			void Trace::Instant(const std::string& _name, const char* _cat, const std::string& _args)
+			{
+				std::string event = EventHead(_name, _cat, 'i', Timer::Stop(), ThreadIndex()) + ",\"s\":\"t\"";
+
+				if (!_args.empty())
+					event += ",\"args\":" + _args;
+
+				event += '}';
+
+				std::lock_guard<std::mutex> lock(mutex);
+				Append(event);
+			}
+
+			void Trace::Flush()
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+
+				WriteBuffer();
+			}
+
+
+			std::string JsonEscape(const std::string& _str)
+			{
+				std::string res;
+				res.reserve(_str.size());
+
+				for (auto it = _str.begin(); it != _str.end(); ++it)
+				{
+					switch (*it)
+					{
+						case '"':
+							res += "\\\"";
+							break;
+						case '\\':
+							res += "\\\\";
+							break;
+						case '\n':
+							res += "\\n";
+							break;
+						case '\t':
+							res += "\\t";
+							break;
+						default:
+						{
+							if (static_cast<unsigned char>(*it) < 0x20)
+							{
+								static const char* const hex = "0123456789abcdef";
+
+								res += "\\u00";
+								res += hex[(*it >> 4) & 0xF];
+								res += hex[*it & 0xF];
+							}
+							else
+								res += *it;
+
+							break;
+						}
+					}
+				}
+
+				return res;
+			}
+
+			unsigned int ThreadIndex() noexcept
+			{
+				static std::atomic<unsigned int> counter{ 0u };
+				thread_local const unsigned int index = counter.fetch_add(1u);
+
+				return index;
+			}
+
+			std::string DateStr()
+			{
+				time_t currTime = time(NULL);
+
+				struct tm timeinfo;
+
+			# if _WIN32
+				localtime_s(&timeinfo, &currTime);
+			#else
+				localtime_r(&currTime, &timeinfo);
+			#endif
+
+				return std::to_string(timeinfo.tm_mon + 1) + '.' +
+					std::to_string(timeinfo.tm_mday) + '.' +
+					std::to_string(timeinfo.tm_year + 1900) + '-' +
+					std::to_string(timeinfo.tm_hour) + 'h' +
+					std::to_string(timeinfo.tm_min) + 'm' +
+					std::to_string(timeinfo.tm_sec) + 's';
+			}
+
+
+			void SetConsoleColor(CslColor _result)
+			{
+				// Recorded logs are output without colors.
+				if (bFlightRecorder && !bDirectLog)
+					return;
+
+				if (ThreadLog::IsBuffered() && !bDirectLog)
+				{
+					ThreadLog::SetColor(_result);
+					return;
+				}
+
+				for (auto it = sinks.begin(); it != sinks.end(); ++it)
+				{
+					if ((*it)->IsEnabled() && (*it)->Accepts(logFlag))
+						(*it)->SetColor(_result);
+				}
+			}
+
+			bool ShouldLog() noexcept
+			{
+				for (auto it = sinks.begin(); it != sinks.end(); ++it)
+				{
+					if ((*it)->IsEnabled())
+						return true;
+				}
+
+				return false;
+			}
+
+			bool ShouldLog(unsigned int _flag) noexcept
+			{
+				if (_flag && !(verbosity & _flag))
+					return false;
+
+				for (auto it = sinks.begin(); it != sinks.end(); ++it)
+				{
+					if ((*it)->IsEnabled() && (*it)->Accepts(_flag))
+						return true;
+				}
+
+				return false;
+			}
+
+			LogFlagScope::LogFlagScope(unsigned int _flag) noexcept :
+				previous{ logFlag }
+			{
+				logFlag = _flag;
+			}
+
+			LogFlagScope::~LogFlagScope()
+			{
+				logFlag = previous;
+			}
+
+			DirectLogScope::DirectLogScope() noexcept :
+				previous{ bDirectLog }
+			{
+				bDirectLog = true;
+			}
+
+			DirectLogScope::~DirectLogScope()
+			{
+				bDirectLog = previous;
+			}
+
+			void LogWrite(const std::string& _str)
+			{
+				if (bFlightRecorder && !bDirectLog)
+				{
+					FlightRecorder::Write(_str);
+					return;
+				}
+
+				if (ThreadLog::IsBuffered() && !bDirectLog)
+				{
+					ThreadLog::Write(_str);
+					return;
+				}
+
+				for (auto it = sinks.begin(); it != sinks.end(); ++it)
+				{
+					if ((*it)->IsEnabled() && (*it)->Accepts(logFlag))
+						(*it)->Write(_str);
+				}
+			}
+
+			void FlushSinks()
+			{
+				for (auto it = sinks.begin(); it != sinks.end(); ++it)
+					(*it)->Flush();
+			}
+
+
+			ThreadLog::Buffer& ThreadLog::LocalBuffer()
+			{
+				// Shared: buffer outlives its thread until merged.
+				thread_local std::shared_ptr<Buffer> buffer = []()
+				{
+					std::shared_ptr<Buffer> res = std::make_shared<Buffer>();
+					res->tid = ThreadIndex();
+
+					std::lock_guard<std::mutex> lock(buffersMutex);
+					buffers.push_back(res);
+
+					return res;
+				}();
+
+				return *buffer;
+			}
+
+			bool ThreadLog::IsBuffered() noexcept
+			{
+				return owner.load(std::memory_order_relaxed) != std::this_thread::get_id();
+			}
+
+			void ThreadLog::Write(const std::string& _str)
+			{
+				Buffer& buffer = LocalBuffer();
+				const uint32_t path = currentPath.load(std::memory_order_relaxed);
+
+				// Only contended during merge.
+				std::lock_guard<std::mutex> lock(buffer.mutex);
+
+				if (!buffer.entries.empty())
+				{
+					Entry& last = buffer.entries.back();
+
+					if (!last.bColor && last.flag == logFlag && last.path == path)
+					{
+						last.text += _str;
+						return;
+					}
+				}
+
+				Entry entry;
+				entry.text = _str;
+				entry.flag = logFlag;
+				entry.path = path;
+
+				buffer.entries.push_back(std::move(entry));
+			}
+
+			void ThreadLog::SetColor(CslColor _color)
+			{
+				Buffer& buffer = LocalBuffer();
+
+				Entry entry;
+				entry.flag = logFlag;
+				entry.path = currentPath.load(std::memory_order_relaxed);
+				entry.bColor = true;
+				entry.color = _color;
+
+				std::lock_guard<std::mutex> lock(buffer.mutex);
+				buffer.entries.push_back(std::move(entry));
+			}
+
+			void ThreadLog::PushPath(const std::string& _name)
+			{
+				owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+				uint32_t id = 0u;
+
+				{
+					std::lock_guard<std::mutex> lock(pathsMutex);
+
+					id = static_cast<uint32_t>(paths.size());
+					paths.push_back(pathStack.empty() ? _name : paths[pathStack.back()] + '/' + _name);
+				}
+
+				pathStack.push_back(id);
+				currentPath.store(id, std::memory_order_relaxed);
+			}
+
+			void ThreadLog::PopPath()
+			{
+				owner.store(std::this_thread::get_id(), std::memory_order_relaxed);
+
+				if (!pathStack.empty())
+					pathStack.pop_back();
+
+				currentPath.store(pathStack.empty() ? 0u : pathStack.back(), std::memory_order_relaxed);
+			}
+
+			uint32_t ThreadLog::CurrentPathId() noexcept
+			{
+				return currentPath.load(std::memory_order_relaxed);
+			}
+
+			std::string ThreadLog::PathName(uint32_t _id)
+			{
+				std::lock_guard<std::mutex> lock(pathsMutex);
+
+				return _id < paths.size() ? paths[_id] : std::string();
+			}
+
+			void ThreadLog::Merge()
+			{
+				if (IsBuffered())
+					return;
+
+				// Take entries: threads keep logging in empty buffers.
+				std::vector<std::pair<unsigned int, std::vector<Entry>>> threads;
+
+				{
+					std::lock_guard<std::mutex> lock(buffersMutex);
+
+					for (auto it = buffers.begin(); it != buffers.end(); ++it)
+					{
+						std::lock_guard<std::mutex> bufferLock((*it)->mutex);
+
+						if ((*it)->entries.empty())
+							continue;
+
+						threads.emplace_back((*it)->tid, std::vector<Entry>{});
+						threads.back().second.swap((*it)->entries);
+					}
+
+					// Remove buffers of finished threads (only referenced here).
+					buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+						[](const std::shared_ptr<Buffer>& _buffer) { return _buffer.use_count() == 1; }), buffers.end());
+				}
+
+				if (threads.empty())
+					return;
+
+				std::sort(threads.begin(), threads.end(),
+					[](const std::pair<unsigned int, std::vector<Entry>>& _lhs, const std::pair<unsigned int, std::vector<Entry>>& _rhs)
+					{
+						return _lhs.first < _rhs.first;
+					});
+
+				std::vector<uint32_t> pathIds;
+
+				for (auto it = threads.begin(); it != threads.end(); ++it)
+				{
+					for (auto entryIt = it->second.begin(); entryIt != it->second.end(); ++entryIt)
+						pathIds.push_back(entryIt->path);
+				}
+
+				std::sort(pathIds.begin(), pathIds.end());
+				pathIds.erase(std::unique(pathIds.begin(), pathIds.end()), pathIds.end());
+
+				// Group begin order, then thread index.
+				for (auto pathIt = pathIds.begin(); pathIt != pathIds.end(); ++pathIt)
+				{
+					std::string path;
+
+					{
+						std::lock_guard<std::mutex> lock(pathsMutex);
+						path = paths[*pathIt];
+					}
+
+					for (auto it = threads.begin(); it != threads.end(); ++it)
+					{
+						bool bHeader = false;
+
+						for (auto entryIt = it->second.begin(); entryIt != it->second.end(); ++entryIt)
+						{
+							if (entryIt->path != *pathIt)
+								continue;
+
+							if (!bHeader && !entryIt->bColor)
+							{
+								LogFlagScope headerScope(Verbosity::None);
+
+								SetConsoleColor(CslColor::None);
+								LogWrite(Group::TabStr() + "[SA-UTH] Thread #" + std::to_string(it->first) +
+									(path.empty() ? std::string() : " in " + path) + ":\n");
+
+								bHeader = true;
+							}
+
+							LogFlagScope flagScope(entryIt->flag);
+
+							if (entryIt->bColor)
+								SetConsoleColor(entryIt->color);
+							else
+								LogWrite(entryIt->text);
+						}
+
+						SetConsoleColor(CslColor::None);
+					}
+				}
+			}
+
+			std::string IndentStr(std::string _str)
+			{
+				const std::string indentStr = std::string("\n") + Group::TabStr();
+
+				size_t index = _str.find('\n');
+
+				while (index != std::string::npos)
+				{
+					_str.replace(index, 1, indentStr);
+
+					index = _str.find('\n', index + indentStr.size());
+				}
+
+				return _str;
+			}
+
+			/// Getter of file name.
+			const char* GetFileNameFromPath(const char* _filePath) noexcept
+			{
+				// Remove characters until last backslash.
+				const char* fileName = strrchr(_filePath, '\\');
+
+				if (!fileName) // No backslash found.
+					fileName = _filePath;
+				else
+					fileName += 1; // Remove last '\\' found.
+
+
+				// Remove characters until last slash.
+				if (const char* filePathNoSlash = strrchr(fileName, '/'))
+				{
+					// Remove last '/' found.
+					fileName = filePathNoSlash + 1;
+				}
+
+				return fileName;
+			}
+		}
+
+
+		bool Sink::Accepts(unsigned int _flag) const noexcept
+		{
+			return !_flag || (verbosity & _flag);
+		}
+
+
+		bool ConsoleSink::IsEnabled() const
+		{
+			return bCslLog;
+		}
+
+		void ConsoleSink::Write(const std::string& _str)
+		{
+			std::cout << _str;
+
+			if (!_str.empty() && _str.back() == '\n')
+				std::cout.flush();
+		}
+
+#if _WIN32
+		void ConsoleSink::SetColor(Intl::CslColor _result)
+		{
+			static HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
+
+			switch (_result)
+			{
+				case Intl::CslColor::None:
+					SetConsoleTextAttribute(hConsole, 15);
+					break;
+				case Intl::CslColor::Title:
+					SetConsoleTextAttribute(hConsole, 14);
+					break;
+				case Intl::CslColor::Success:
+					SetConsoleTextAttribute(hConsole, 10);
+					break;
+				case Intl::CslColor::Failure:
+					SetConsoleTextAttribute(hConsole, 12);
+					break;
+				case Intl::CslColor::TestNum:
+					SetConsoleTextAttribute(hConsole, 6);
+					break;
+				case Intl::CslColor::GroupBegin:
+					SetConsoleTextAttribute(hConsole, 3);
+					break;
+				case Intl::CslColor::GroupEnd:
+					SetConsoleTextAttribute(hConsole, 3);
+					break;
+				case Intl::CslColor::Init:
+					SetConsoleTextAttribute(hConsole, 13);
+					break;
+				case Intl::CslColor::Exit:
+					SetConsoleTextAttribute(hConsole, 13);
+					break;
+				case Intl::CslColor::ParamWarning:
+					SetConsoleTextAttribute(hConsole, 6);
+					break;
+				case Intl::CslColor::Bench:
+					SetConsoleTextAttribute(hConsole, 11);
+					break;
+				default:
+					std::cout << "CslColor not supported yet!" << std::endl;
+					break;
+			}
+		}
+#else
+		void ConsoleSink::SetColor(Intl::CslColor _result)
+		{
+			switch (_result)
+			{
+				case Intl::CslColor::None:
+					std::cout << "\033[0;0m";
+					break;
+				case Intl::CslColor::Title:
+					std::cout << "\033[0;33m";
+					break;
+				case Intl::CslColor::Success:
+					std::cout << "\033[0;32m";
+					break;
+				case Intl::CslColor::Failure:
+					std::cout << "\033[0;31m";
+					break;
+				case Intl::CslColor::TestNum:
+					std::cout << "\033[1;33m";
+					break;
+				case Intl::CslColor::GroupBegin:
+					std::cout << "\033[1;34m";
+					break;
+				case Intl::CslColor::GroupEnd:
+					std::cout << "\033[1;34m";
+					break;
+				case Intl::CslColor::Init:
+					std::cout << "\033[0;35m";
+					break;
+				case Intl::CslColor::Exit:
+					std::cout << "\033[0;35m";
+					break;
+				case Intl::CslColor::ParamWarning:
+					std::cout << "\033[1;33m";
+					break;
+				case Intl::CslColor::Bench:
+					std::cout << "\033[0;36m";
+					break;
+				default:
+					std::cout << "CslColor not supported yet!" << std::endl;
+					break;
+			}
+		}
+#endif
+
+		void ConsoleSink::Flush()
+		{
+			std::cout.flush();
+		}
+
+
+		FileSink::FileSink(const std::string& _fileName) :
+			file(_fileName, std::ios::out | std::ios::trunc)
+		{
+		}
+
+		bool FileSink::IsEnabled() const
+		{
+			// Default log file sink.
+			if (!file.is_open())
+				return bFileLog;
+
+			return true;
+		}
+
+		void FileSink::Write(const std::string& _str)
+		{
+			std::ostream& out = file.is_open() ? static_cast<std::ostream&>(file) : Intl::Logger::instance.logFile;
+
+			out << _str;
+
+			if (!_str.empty() && _str.back() == '\n')
+				out.flush();
+		}
+
+		void FileSink::Flush()
+		{
+			if (file.is_open())
+				file.flush();
+			else
+				Intl::Logger::instance.logFile.flush();
+		}
+
+
+		void MemorySink::Write(const std::string& _str)
+		{
+			line += _str;
+
+			// Split complete lines.
+			size_t index = line.find('\n');
+
+			while (index != std::string::npos)
+			{
+				lines.push_back(line.substr(0u, index));
+				line.erase(0u, index + 1u);
+
+				index = line.find('\n');
+			}
+		}
+
+		void MemorySink::Clear()
+		{
+			lines.clear();
+			line.clear();
+		}
+
+
+		CallbackSink::CallbackSink(void (*_callback)(const std::string& _line, void* _userData), void* _userData) :
+			callback{ _callback },
+			userData{ _userData }
+		{
+		}
+
+		void CallbackSink::Write(const std::string& _str)
+		{
+			line += _str;
+
+			size_t index = line.find('\n');
+
+			while (index != std::string::npos)
+			{
+				if (callback)
+					callback(line.substr(0u, index), userData);
+
+				line.erase(0u, index + 1u);
+
+				index = line.find('\n');
+			}
+		}
+
+
+		void AddSink(Sink& _sink)
+		{
+			if (std::find(Intl::sinks.begin(), Intl::sinks.end(), &_sink) == Intl::sinks.end())
+				Intl::sinks.push_back(&_sink);
+		}
+
+		void RemoveSink(Sink& _sink)
+		{
+			Intl::sinks.erase(std::remove(Intl::sinks.begin(), Intl::sinks.end(), &_sink), Intl::sinks.end());
+		}
+
+//}
+
+
+//{ Timer
+
+		const Timer::Calibration& Timer::GetCalibration()
+		{
+			static const Calibration calibration = []()
+			{
+				Calibration res;
+
+			#if defined(__x86_64__) || defined(_M_X64)
+				// Use TSC only if invariant (constant rate across P-states and cores).
+				unsigned int regs[4] = {};
+
+			#if _WIN32
+				__cpuid(reinterpret_cast<int*>(regs), 0x80000007);
+			#else
+				__get_cpuid(0x80000007, &regs[0], &regs[1], &regs[2], &regs[3]);
+			#endif
+
+				res.bCycleCounter = (regs[3] & (1u << 8)) != 0u;
+			#elif defined(__aarch64__)
+				res.bCycleCounter = true;
+			#endif
+
+				// Tick duration.
+				if (res.bCycleCounter)
+				{
+				#if defined(__aarch64__)
+					uint64_t freq = 0u;
+					asm volatile("mrs %0, cntfrq_el0" : "=r"(freq));
+
+					res.nsPerTick = freq ? 1e9 / static_cast<double>(freq) : 1.0;
+				#else
+					// Count ticks during a short steady_clock interval.
+					using Clock = std::chrono::steady_clock;
+
+					const Clock::time_point clockStart = Clock::now();
+					const uint64_t tickStart = StartTicks(true);
+
+					while (Clock::now() - clockStart < std::chrono::milliseconds(20))
+						;
+
+					const uint64_t tickEnd = StopTicks(true);
+					const double ns = std::chrono::duration<double, std::nano>(Clock::now() - clockStart).count();
+
+					res.nsPerTick = tickEnd > tickStart ? ns / static_cast<double>(tickEnd - tickStart) : 1.0;
+				#endif
+				}
+
+				// Some virtualized counters cost more than steady_clock: keep the cheapest.
+				if (res.bCycleCounter)
+				{
+					const auto pairCost = [](bool _bCycleCounter)
+					{
+						using Clock = std::chrono::steady_clock;
+						constexpr unsigned int count = 10000u;
+
+						uint64_t ticks = 0u;
+						const Clock::time_point start = Clock::now();
+
+						for (unsigned int i = 0u; i < count; ++i)
+						{
+							const uint64_t begin = StartTicks(_bCycleCounter);
+							ticks += StopTicks(_bCycleCounter) - begin;
+						}
+
+						const double ns = std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+
+						volatile uint64_t sink = ticks;
+						(void)sink;
+
+						return ns / count;
+					};
+
+					if (pairCost(false) < pairCost(true))
+					{
+						res.bCycleCounter = false;
+						res.nsPerTick = 1.0;
+					}
+				}
+
+				// Overhead: minimum of empty Start/Stop pairs.
+				double overhead = -1.0;
+
+				for (unsigned int i = 0u; i < 1000u; ++i)
+				{
+					const uint64_t start = StartTicks(res.bCycleCounter);
+					const uint64_t stop = StopTicks(res.bCycleCounter);
+
+					const double ticks = static_cast<double>(stop - start);
+
+					if (overhead < 0.0 || ticks < overhead)
+						overhead = ticks;
+				}
+
+				res.overhead = overhead > 0.0 ? overhead : 0.0;
+
+				return res;
+			}();
+
+			return calibration;
+		}
+
+		uint64_t Timer::StartTicks(bool _bCycleCounter) noexcept
+		{
+			if (_bCycleCounter)
+			{
+			#if defined(__x86_64__) || defined(_M_X64)
+				// Wait for previous instructions before reading.
+				_mm_lfence();
+				const uint64_t ticks = __rdtsc();
+				_mm_lfence();
+
+				return ticks;
+			#elif defined(__aarch64__)
+				uint64_t ticks = 0u;
+				asm volatile("isb; mrs %0, cntvct_el0" : "=r"(ticks) : : "memory");
+
+				return ticks;
+			#endif
+			}
+
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		uint64_t Timer::StopTicks(bool _bCycleCounter) noexcept
+		{
+			if (_bCycleCounter)
+			{
+			#if defined(__x86_64__) || defined(_M_X64)
+				// rdtscp waits for previous instructions, lfence prevents next ones from starting before.
+				unsigned int aux = 0u;
+				const uint64_t ticks = __rdtscp(&aux);
+				_mm_lfence();
+
+				return ticks;
+			#elif defined(__aarch64__)
+				uint64_t ticks = 0u;
+				asm volatile("isb; mrs %0, cntvct_el0" : "=r"(ticks) : : "memory");
+
+				return ticks;
+			#endif
+			}
+
+			return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count());
+		}
+
+		uint64_t Timer::Start() noexcept
+		{
+			return StartTicks(GetCalibration().bCycleCounter);
+		}
+
+		uint64_t Timer::Stop() noexcept
+		{
+			return StopTicks(GetCalibration().bCycleCounter);
+		}
+
+		double Timer::Elapsed(uint64_t _start, uint64_t _stop)
+		{
+			const Calibration& calibration = GetCalibration();
+
+			if (_stop <= _start)
+				return 0.0;
+
+			const double ticks = static_cast<double>(_stop - _start) - calibration.overhead;
+
+			return ticks > 0.0 ? ticks * calibration.nsPerTick : 0.0;
+		}
+
+		double Timer::ToNs(double _ticks)
+		{
+			return _ticks * GetCalibration().nsPerTick;
+		}
+
+		double Timer::Overhead()
+		{
+			return ToNs(GetCalibration().overhead);
+		}
+
+		bool Timer::IsCycleCounter()
+		{
+			return GetCalibration().bCycleCounter;
+		}
+
+		void Timer::Calibrate()
+		{
+			(void)GetCalibration();
+		}
+
+//}
+
+
+//{ Usage
+
+		Usage Usage::Capture() noexcept
+		{
+			Usage res;
+
+		#if _WIN32
+			FILETIME creation, exit, kernel, user;
+
+			if (GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+			{
+				// FILETIME: 100ns intervals.
+				res.userTime = (static_cast<double>(user.dwHighDateTime) * 4294967296.0 + user.dwLowDateTime) * 100.0;
+				res.sysTime = (static_cast<double>(kernel.dwHighDateTime) * 4294967296.0 + kernel.dwLowDateTime) * 100.0;
+			}
+		#else
+			struct rusage usage{};
+
+		#ifdef RUSAGE_THREAD
+			const int who = RUSAGE_THREAD;
+		#else
+			const int who = RUSAGE_SELF;
+		#endif
+
+			if (getrusage(who, &usage) == 0)
+			{
+				res.userTime = usage.ru_utime.tv_sec * 1e9 + usage.ru_utime.tv_usec * 1e3;
+				res.sysTime = usage.ru_stime.tv_sec * 1e9 + usage.ru_stime.tv_usec * 1e3;
+				res.minorFaults = usage.ru_minflt;
+				res.majorFaults = usage.ru_majflt;
+				res.voluntarySwitches = usage.ru_nvcsw;
+				res.involuntarySwitches = usage.ru_nivcsw;
+				res.blockInputs = usage.ru_inblock;
+				res.blockOutputs = usage.ru_oublock;
+			}
+		#endif
+
+			return res;
+		}
+
+		Usage Usage::operator-(const Usage& _rhs) const noexcept
+		{
+			Usage res;
+
+			res.userTime = userTime - _rhs.userTime;
+			res.sysTime = sysTime - _rhs.sysTime;
+			res.minorFaults = minorFaults - _rhs.minorFaults;
+			res.majorFaults = majorFaults - _rhs.majorFaults;
+			res.voluntarySwitches = voluntarySwitches - _rhs.voluntarySwitches;
+			res.involuntarySwitches = involuntarySwitches - _rhs.involuntarySwitches;
+			res.blockInputs = blockInputs - _rhs.blockInputs;
+			res.blockOutputs = blockOutputs - _rhs.blockOutputs;
+
+			return res;
+		}
+
+		void Usage::Log() const
+		{
+			using namespace Intl;
+
+			SA_UTH_LOG("\tcpu: user " << FormatDuration(userTime) << ", sys " << FormatDuration(sysTime) <<
+				"\tfaults: minor " << minorFaults << ", major " << majorFaults <<
+				"\tswitches: voluntary " << voluntarySwitches << ", involuntary " << involuntarySwitches <<
+				"\tblock I/O: in " << blockInputs << ", out " << blockOutputs);
+		}
+
+//}
+
+
+//{ Counter
+
+		Counter::Counter(const Counter& _other) noexcept :
+			success{ _other.success.load(std::memory_order_relaxed) },
+			failure{ _other.failure.load(std::memory_order_relaxed) }
+		{
+		}
+
+		Counter& Counter::operator=(const Counter& _rhs) noexcept
+		{
+			success.store(_rhs.success.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			failure.store(_rhs.failure.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+			return *this;
+		}
+
+		unsigned int Counter::Total() const
+		{
+			return success.load(std::memory_order_relaxed) + failure.load(std::memory_order_relaxed);
+		}
+
+		void Counter::Update(bool _pred)
+		{
+			if (_pred)
+				success.fetch_add(1u, std::memory_order_relaxed);
+			else
+				failure.fetch_add(1u, std::memory_order_relaxed);
+		}
+
+		Counter& Counter::operator+=(const Counter& _rhs) noexcept
+		{
+			success.fetch_add(_rhs.success.load(std::memory_order_relaxed), std::memory_order_relaxed);
+			failure.fetch_add(_rhs.failure.load(std::memory_order_relaxed), std::memory_order_relaxed);
+
+			return *this;
+		}
+
+		void Counter::Log() const
+		{
+			using namespace Intl;
+
+			SetConsoleColor(CslColor::TestNum);
+			__SA_UTH_LOG_IN(Total());
+
+			if (failure)
+			{
+				__SA_UTH_LOG_IN(" (");
+
+				SetConsoleColor(CslColor::Success);
+				__SA_UTH_LOG_IN(success);
+
+				SetConsoleColor(CslColor::TestNum);
+				__SA_UTH_LOG_IN('/');
+
+				SetConsoleColor(CslColor::Failure);
+				__SA_UTH_LOG_IN(failure);
+
+				SetConsoleColor(CslColor::TestNum);
+				__SA_UTH_LOG_IN(')');
+			}
+		}
+
+		bool Counter::IsEmpty() const
+		{
+			return success != 0 && failure != 0;
+		}
+
+//}
+
+
+//{ Zone
+
+		void ZoneStats::Log() const
+		{
+			using namespace Intl;
+
+			SA_UTH_LOG("\tzone: " << name << "\tcount: " << count <<
+				"\ttotal: " << FormatDuration(total) <<
+				"\tmean: " << FormatDuration(count ? total / count : 0.0) <<
+				"\tmax: " << FormatDuration(max));
+		}
+
+		Zone::Zone(const char* _name) noexcept :
+			name{ _name },
+			start{ Timer::Start() }
+		{
+		}
+
+		Zone::~Zone()
+		{
+			const uint64_t stop = Timer::Stop();
+
+			Intl::LocalZoneBuffer().Push(Intl::ZoneRecord{ name, start, stop });
+		}
+
+		namespace Intl
+		{
+			void ZoneBuffer::Push(const ZoneRecord& _record) noexcept
+			{
+				const size_t index = head.load(std::memory_order_relaxed);
+
+				if (index - tail.load(std::memory_order_acquire) >= capacity)
+				{
+					dropped.fetch_add(1u, std::memory_order_relaxed);
+					return;
+				}
+
+				records[index % capacity] = _record;
+
+				// Publish record to the flushing thread.
+				head.store(index + 1u, std::memory_order_release);
+			}
+
+			ZoneBuffer& LocalZoneBuffer()
+			{
+				thread_local const std::shared_ptr<ZoneBuffer> buffer = []()
+				{
+					std::shared_ptr<ZoneBuffer> res = std::make_shared<ZoneBuffer>();
+					res->tid = ThreadIndex();
+
+					std::lock_guard<std::mutex> lock(zoneMutex);
+					zoneBuffers.push_back(res);
+
+					return res;
+				}();
+
+				return *buffer;
+			}
+
+			uint64_t FlushZones(std::vector<ZoneStats>* _stats)
+			{
+				std::lock_guard<std::mutex> lock(zoneMutex);
+
+				uint64_t dropped = 0u;
+
+				for (auto it = zoneBuffers.begin(); it != zoneBuffers.end(); ++it)
+				{
+					ZoneBuffer& buffer = **it;
+
+					const size_t head = buffer.head.load(std::memory_order_acquire);
+					size_t tail = buffer.tail.load(std::memory_order_relaxed);
+
+					for (; tail != head; ++tail)
+					{
+						const ZoneRecord& record = buffer.records[tail % ZoneBuffer::capacity];
+
+						if (bTrace)
+							Trace::instance.Complete(buffer.tid, record.name, "zone", record.start, record.stop);
+
+						if (_stats)
+						{
+							const double ns = Timer::Elapsed(record.start, record.stop);
+
+							auto stat = std::find_if(_stats->begin(), _stats->end(),
+								[&record](const ZoneStats& _stat) { return _stat.name == record.name; });
+
+							if (stat == _stats->end())
+							{
+								_stats->push_back(ZoneStats{ record.name });
+								stat = _stats->end() - 1;
+							}
+
+							++stat->count;
+							stat->total += ns;
+							stat->max = (std::max)(stat->max, ns);
+						}
+					}
+
+					// Release slots to the recording thread.
+					buffer.tail.store(tail, std::memory_order_release);
+
+					dropped += buffer.dropped.exchange(0u, std::memory_order_relaxed);
+				}
+
+				return dropped;
+			}
+
+			void MergeZoneStats(std::vector<ZoneStats>& _dst, const std::vector<ZoneStats>& _src)
+			{
+				for (auto it = _src.begin(); it != _src.end(); ++it)
+				{
+					auto stat = std::find_if(_dst.begin(), _dst.end(),
+						[it](const ZoneStats& _stat) { return _stat.name == it->name; });
+
+					if (stat == _dst.end())
+						_dst.push_back(*it);
+					else
+					{
+						stat->count += it->count;
+						stat->total += it->total;
+						stat->max = (std::max)(stat->max, it->max);
+					}
+				}
+			}
+		}
+
+//}
+
+
+//{ Title
+
+		void Title::Log() const
+		{
+			using namespace Intl;
+
+			// Failures are always output.
+			LogFlagScope flagScope(pred ? Verbosity::Success : Verbosity::None);
+
+			SetConsoleColor(CslColor::Title);
+
+			Group::LogTabs();
+			__SA_UTH_LOG_IN("[SA-UTH] ");
+
+			// Result.
+			if (pred)
+			{
+				SetConsoleColor(CslColor::Success);
+				__SA_UTH_LOG_IN("Success ");
+			}
+			else
+			{
+				SetConsoleColor(CslColor::Failure);
+				__SA_UTH_LOG_IN("Failure ");
+			}
+
+			SetConsoleColor(CslColor::Title);
+
+			__SA_UTH_LOG_IN(funcDecl << " -- " << fileName << ":" << lineNum << std::endl);
+
+			SetConsoleColor(CslColor::None);
+		}
+
+//}
+
+
+//{ Group
+
+		void Group::Update(bool _pred)
+		{
+			// Update top group (worker threads never access sGroups): End can't pop it while updating.
+			sUpdating.fetch_add(1u);
+
+			if (Group* const gp = sTop.load())
+			{
+				gp->count.Update(_pred);
+
+				if (!_pred)
+				{
+					std::lock_guard<std::mutex> lock(Intl::failureMutex);
+					gp->localExit = EXIT_FAILURE;
+				}
+			}
+
+			sUpdating.fetch_sub(1u, std::memory_order_release);
+		}
+
+		void Group::Spread(Group& _parent)
+		{
+			if (localExit == EXIT_FAILURE)
+			{
+				std::lock_guard<std::mutex> lock(Intl::failureMutex);
+				_parent.localExit = EXIT_FAILURE;
+			}
+
+			_parent.count += count;
+
+			Intl::MergeZoneStats(_parent.zones, zones);
+		}
+
+		void Group::Begin(const std::string& _name)
+		{
+			// Logs of other threads belong to the previous groups.
+			Intl::ThreadLog::Merge();
+
+			// Log before push for log indentation.
+			if (Intl::ShouldLog(Verbosity::GroupStart))
+				BeginLog(_name);
+
+			// Zones run before this group belong to the parent.
+			if (!sGroups.empty())
+				LogZonesDropped(Intl::FlushZones(&sGroups.back().zones));
+
+			sGroups.push_back(Group{ _name });
+			sGroups.back().usage = Usage::Capture();
+
+			sTop.store(&sGroups.back());
+			sDepth.store(sGroups.size(), std::memory_order_release);
+
+			Intl::ThreadLog::PushPath(_name);
+			Intl::StatsGroup();
+
+			if (sGroups.size() == 1u)
+				Intl::ProgressGroup(true, _name);
+
+			{
+				std::lock_guard<std::mutex> lock(Intl::softFailuresMutex);
+				sGroups.back().softFailureIndex = Intl::softFailures.size();
+			}
+
+			Intl::ProfileGroupBegin(_name);
+			sGroups.back().beginTicks = Timer::Start();
+
+			if (bTrace)
+				Intl::Trace::instance.Begin(_name, "group");
+
+			if (GroupBeginCB)
+				GroupBeginCB(_name);
+
+			Intl::Notify(Event::GroupBegin, [&_name](Listener& _listener) { _listener.OnGroupBegin(_name); });
+		}
+
+		Group Group::End()
+		{
+			const uint64_t endTicks = Timer::Stop();
+
+			// Soft failures and logs of other threads are output inside the group (indentation), out of group time.
+			Intl::ThreadLog::Merge();
+			Intl::ReportSoftFailures(sGroups.back().softFailureIndex);
+
+			LogZonesDropped(Intl::FlushZones(&sGroups.back().zones));
+
+			Intl::ProfileGroupEnd();
+
+			if (ResultBatchCB)
+				Intl::FlushResults();
+
+			if (bTrace)
+				Intl::Trace::instance.End(sGroups.back().name, "group");
+
+			// Next updates go to the parent: wait for the running ones before copy and pop.
+			sTop.store(sGroups.size() > 1u ? &sGroups[sGroups.size() - 2u] : nullptr);
+			sDepth.store(sGroups.size() - 1u, std::memory_order_release);
+
+			while (sUpdating.load())
+				std::this_thread::yield();
+
+			Group group = sGroups.back();
+			sGroups.pop_back();
+
+			Intl::ThreadLog::PopPath();
+
+			group.time = Timer::Elapsed(group.beginTicks, endTicks);
+			group.usage = Usage::Capture() - group.usage;
+
+			if (sGroups.empty())
+				Intl::ProgressGroup(false, group.name, group.time);
+
+			// Spread values to parent.
+			if (!sGroups.empty())
+				group.Spread(sGroups.back());
+
+			if (Intl::ShouldLog(Verbosity::GroupExit))
+				EndLog(group);
+
+			// Logs following the dumped failure, up to the group end line.
+			if (group.localExit == EXIT_FAILURE && bFlightRecorder)
+				Intl::FlightRecorder::Flush();
+
+			if (GroupEndCB)
+				GroupEndCB(group);
+
+			Intl::Notify(Event::GroupEnd, [&group](Listener& _listener) { _listener.OnGroupEnd(group); });
+
+			globalCount.Update(group.localExit == EXIT_SUCCESS);
+
+			Intl::StatsGroup();
+
+			return group;
+		}
+
+
+		bool Group::IsRunning() noexcept
+		{
+			return sDepth.load(std::memory_order_acquire) != 0u;
+		}
+
+
+		template <typename FuncT>
+		void Group::Run(const std::string& _name, FuncT&& _body)
+		{
+			Begin(_name);
+
+			_body();
+
+			End();
+		}
+
+		template <typename FuncT>
+		void Group::Run(const std::string& _name, FuncT&& _body, const GroupLimits& _limits,
+			const std::string& _fileName, unsigned int _lineNum)
+		{
+		#if _WIN32
+			using namespace Intl;
+
+			(void)_limits;
+			(void)_fileName;
+			(void)_lineNum;
+
+			SetConsoleColor(CslColor::ParamWarning);
+			SA_UTH_LOG("[SA-UTH] Group limits not supported on this platform: run " << _name << " in-process.");
+			SetConsoleColor(CslColor::None);
+
+			Run(_name, _body);
+		#else
+			/// Plain counts sent through the pipe (Counter is atomic).
+			struct Count
+			{
+				unsigned int success = 0u;
+				unsigned int failure = 0u;
+			};
+
+			/// Results sent by the child process.
+			struct Report
+			{
+				LimitFailure failure = LimitFailure::None;
+				Count count;
+				bool localExit = EXIT_SUCCESS;
+				Count globalCount;
+				Count groupGlobalCount;
+				int exit = EXIT_SUCCESS;
+
+				/// Peak address space (compared to RLIMIT_AS).
+				size_t addressSpace = 0u;
+			};
+
+			Begin(_name);
+
+			// Avoid buffered output to be written twice.
+			Intl::ThreadLog::Merge();
+			Intl::FlushSinks();
+			Intl::Trace::instance.Flush();
+
+			// Child output is not overwritten by the progress line.
+			Intl::ProgressPause(true);
+
+			int fds[2];
+
+			const bool bPipe = pipe(fds) == 0;
+			const pid_t pid = bPipe ? fork() : -1;
+
+			if (pid < 0)
+			{
+				const int error = errno;
+
+				if (bPipe)
+				{
+					close(fds[0]);
+					close(fds[1]);
+				}
+
+				Intl::ProgressPause(false);
+
+				Intl::SetConsoleColor(Intl::CslColor::ParamWarning);
+				SA_UTH_LOG("[SA-UTH] Group limits: " << (bPipe ? "fork" : "pipe") << " failed (" << strerror(error) <<
+					"): run " << _name << " in-process.");
+				Intl::SetConsoleColor(Intl::CslColor::None);
+
+				_body();
+				End();
+				return;
+			}
+
+			if (pid == 0)
+			{
+				// Child process: apply limits, run body then report.
+				close(fds[0]);
+
+				Intl::ProgressDetach();
+
+				// Parent failures are logged by the parent.
+				Intl::failureRecords.clear();
+				Intl::failureRecordsDropped = 0u;
+
+				if (_limits.memory)
+				{
+					const rlimit limit{ static_cast<rlim_t>(_limits.memory), static_cast<rlim_t>(_limits.memory) };
+					setrlimit(RLIMIT_AS, &limit);
+				}
+
+				if (_limits.cpuTime)
+				{
+					// SIGXCPU on soft limit, SIGKILL one second later.
+					const rlimit limit{ static_cast<rlim_t>(_limits.cpuTime), static_cast<rlim_t>(_limits.cpuTime + 1u) };
+					setrlimit(RLIMIT_CPU, &limit);
+				}
+
+				const Counter globalCountBegin = Intl::globalCount;
+				const Counter groupGlobalCountBegin = globalCount;
+
+				Report report;
+
+				const size_t depth = sGroups.size();
+
+				try
+				{
+					_body();
+				}
+				catch (const std::bad_alloc&)
+				{
+					report.failure = LimitFailure::Memory;
+
+					// Close nested groups left open by the throw.
+					while (sGroups.size() > depth)
+						End();
+				}
+
+				report.addressSpace = Intl::PeakAddressSpace();
+
+				// Soft failures of the child process are lost on exit.
+				Intl::ReportSoftFailures(sGroups.back().softFailureIndex);
+
+				report.count.success = sGroups.back().count.success;
+				report.count.failure = sGroups.back().count.failure;
+				report.localExit = sGroups.back().localExit;
+				report.globalCount.success = Intl::globalCount.success - globalCountBegin.success;
+				report.globalCount.failure = Intl::globalCount.failure - globalCountBegin.failure;
+				report.groupGlobalCount.success = globalCount.success - groupGlobalCountBegin.success;
+				report.groupGlobalCount.failure = globalCount.failure - groupGlobalCountBegin.failure;
+				report.exit = UTH::exit;
+
+				// Records of the child process are lost on exit.
+				Intl::LogFailureStacks();
+
+				Intl::FlushResults();
+				Intl::ThreadLog::Merge();
+				Intl::FlushSinks();
+				Intl::FlushZones(nullptr);
+				Intl::Trace::instance.Flush();
+
+				const ssize_t written = write(fds[1], &report, sizeof(Report));
+				(void)written;
+
+				close(fds[1]);
+				_exit(EXIT_SUCCESS);
+			}
+
+			// Parent process: wait for child report.
+			close(fds[1]);
+
+			Report report;
+			const bool bReport = read(fds[0], &report, sizeof(Report)) == static_cast<ssize_t>(sizeof(Report));
+
+			close(fds[0]);
+
+			int status = 0;
+			struct rusage childUsage{};
+
+			wait4(pid, &status, 0, &childUsage);
+
+			Intl::ProgressPause(false);
+
+			Group& group = sGroups.back();
+
+			if (bReport)
+			{
+				// Apply child results.
+				group.count.success += report.count.success;
+				group.count.failure += report.count.failure;
+
+				if (report.localExit == EXIT_FAILURE)
+					group.localExit = EXIT_FAILURE;
+
+				Intl::globalCount.success += report.globalCount.success;
+				Intl::globalCount.failure += report.globalCount.failure;
+				globalCount.success += report.groupGlobalCount.success;
+				globalCount.failure += report.groupGlobalCount.failure;
+
+				if (report.exit == EXIT_FAILURE)
+					UTH::exit = EXIT_FAILURE;
+
+				group.limitFailure = report.failure;
+			}
+			else if (WIFSIGNALED(status) && (WTERMSIG(status) == SIGXCPU || WTERMSIG(status) == SIGKILL) && _limits.cpuTime)
+				group.limitFailure = LimitFailure::CpuTime;
+			else
+				group.limitFailure = LimitFailure::Crash;
+
+			if (group.limitFailure != LimitFailure::None)
+			{
+				const double cpuTime = childUsage.ru_utime.tv_sec + childUsage.ru_utime.tv_usec * 1e-6 +
+					childUsage.ru_stime.tv_sec + childUsage.ru_stime.tv_usec * 1e-6;
+
+			#if __APPLE__
+				const size_t resident = static_cast<size_t>(childUsage.ru_maxrss);
+			#else
+				const size_t resident = static_cast<size_t>(childUsage.ru_maxrss) * 1024u;
+			#endif
+
+				Intl::ComputeLimitFailure(group, _limits, cpuTime, bReport ? report.addressSpace : 0u, resident, status, _fileName, _lineNum);
+			}
+
+			End();
+		#endif
+		}
+
+		void Group::BeginLog(const std::string& _name)
+		{
+			using namespace Intl;
+
+			LogFlagScope flagScope(Verbosity::GroupStart);
+
+			SetConsoleColor(CslColor::GroupBegin);
+			SA_UTH_LOG("[SA-UTH] Group:\t" << _name);
+			SetConsoleColor(CslColor::None);
+		}
+
+		void Group::EndLog(const UTH::Group& _group)
+		{
+			using namespace Intl;
+
+			LogFlagScope flagScope(Verbosity::GroupExit);
+
+			LogTabs();
+			SetConsoleColor(CslColor::GroupEnd);
+
+			__SA_UTH_LOG_IN("[SA-UTH] Group:\t" << _group.name << " run: ");
+
+			_group.count.Log();
+
+			SetConsoleColor(CslColor::GroupEnd);
+			__SA_UTH_LOG_IN(" and exit with code: ");
+
+			if (_group.localExit == EXIT_SUCCESS)
+			{
+				SetConsoleColor(CslColor::Success);
+				__SA_UTH_LOG_IN("EXIT_SUCCESS (" << EXIT_SUCCESS << ')');
+			}
+			else
+			{
+				SetConsoleColor(CslColor::Failure);
+				__SA_UTH_LOG_IN("EXIT_FAILURE (" << EXIT_FAILURE << ')');
+			}
+
+			if (verbosity & Verbosity::GroupTime)
+			{
+				SetConsoleColor(CslColor::GroupEnd);
+				__SA_UTH_LOG_IN(" in " << FormatDuration(_group.time));
+			}
+
+			__SA_UTH_LOG_ENDL();
+
+			if (ShouldLog(Verbosity::GroupUsage))
+			{
+				LogFlagScope usageScope(Verbosity::GroupUsage);
+
+				SetConsoleColor(CslColor::GroupEnd);
+				_group.usage.Log();
+			}
+
+			if (ShouldLog(Verbosity::GroupZones) && !_group.zones.empty())
+			{
+				LogFlagScope zonesScope(Verbosity::GroupZones);
+
+				SetConsoleColor(CslColor::GroupEnd);
+
+				// Slowest zones first.
+				std::vector<ZoneStats> zones = _group.zones;
+				std::sort(zones.begin(), zones.end(),
+					[](const ZoneStats& _lhs, const ZoneStats& _rhs) { return _lhs.total > _rhs.total; });
+
+				for (auto it = zones.begin(); it != zones.end(); ++it)
+				{
+					LogTabs();
+					it->Log();
+				}
+			}
+
+			SetConsoleColor(CslColor::None);
+		}
+
+
+		void Group::LogZonesDropped(uint64_t _dropped)
+		{
+			using namespace Intl;
+
+			if (!_dropped || !ShouldLog())
+				return;
+
+			SetConsoleColor(CslColor::ParamWarning);
+			SA_UTH_LOG("[SA-UTH] Zone buffer full: " << _dropped << " zone records dropped.");
+			SetConsoleColor(CslColor::None);
+		}
+
+		std::string Group::TabStr() noexcept
+		{
+			return std::string(sDepth.load(std::memory_order_acquire), '\t');
+		}
+
+		void Group::LogTabs() noexcept
+		{
+			if (sDepth.load(std::memory_order_acquire))
+				__SA_UTH_LOG_IN(TabStr());
+		}
+
+//}
+
+
+//{ Param
+
+		void Param::Log(const std::vector<Param>& _params)
+		{
+			using namespace Intl;
+
+			for (auto it = _params.begin(); it != _params.end(); ++it)
+			{
+				if (verbosity & Verbosity::ParamsName)
+					SA_UTH_LOG(it->name << ':');
+
+				// ToString not implemented.
+				if (it->value.empty())
+				{
+					__SA_UTH_LOG_IN("-No debug string-\t");
+					SetConsoleColor(CslColor::ParamWarning);
+					__SA_UTH_LOG_IN("Implement ToString() in class or UTH::ToString template specialization.");
+					SetConsoleColor(CslColor::None);
+				}
+				else
+					SA_UTH_LOG(IndentStr(it->value));
+			}
+		}
+
+
+		template <typename T>
+		ParamView ParamView::Make(std::string _name, const T& _value) noexcept
+		{
+			ParamView view;
+
+			view.value = &_value;
+			view.toString = [](const void* _ptr) { return Sa::UTH::ToString(*static_cast<const T*>(_ptr)); };
+			view.typeName = &Intl::TypeName<T>;
+			view.name = std::move(_name);
+
+			return view;
+		}
+
+		template <typename T>
+		ParamView ParamView::Snapshot(std::string _name, const T& _value)
+		{
+			ParamView view;
+
+			if constexpr (std::is_copy_constructible_v<T>)
+			{
+				std::shared_ptr<const T> copy = std::make_shared<const T>(_value);
+
+				view.value = copy.get();
+				view.toString = [](const void* _ptr) { return Sa::UTH::ToString(*static_cast<const T*>(_ptr)); };
+				view.storage = std::move(copy);
+			}
+			else
+			{
+				std::shared_ptr<const std::string> str = std::make_shared<const std::string>(Sa::UTH::ToString(_value));
+
+				view.value = str.get();
+				view.toString = [](const void* _ptr) { return *static_cast<const std::string*>(_ptr); };
+				view.storage = std::move(str);
+			}
+
+			view.typeName = &Intl::TypeName<T>;
+			view.name = std::move(_name);
+
+			return view;
+		}
+
+		const char* ParamView::TypeName() const
+		{
+			return typeName ? typeName() : "";
+		}
+
+		std::string ParamView::ToString() const
+		{
+			return toString ? toString(value) : std::string();
+		}
+
+
+		namespace Intl
+		{
+			template <typename T>
+			const char* TypeName()
+			{
+			#if defined(__clang__) || defined(__GNUC__)
+				// const char* Sa::UTH::Intl::TypeName() [with T = int]
+				static const std::string sig = __PRETTY_FUNCTION__;
+			#elif defined(_MSC_VER)
+				// const char *__cdecl Sa::UTH::Intl::TypeName<int>(void)
+				static const std::string sig = __FUNCSIG__;
+			#else
+				static const std::string sig;
+			#endif
+
+				// Signature must be captured outside of the lambda (would be the lambda's one).
+				static const std::string name = []()
+				{
+				#if defined(__clang__) || defined(__GNUC__)
+					size_t begin = sig.find("T = ");
+					begin = begin == std::string::npos ? begin : begin + 4u;
+					// Last bracket: the type may contain some (int [3]).
+					const size_t end = sig.rfind(']');
+				#elif defined(_MSC_VER)
+					size_t begin = sig.find("TypeName<");
+					begin = begin == std::string::npos ? begin : begin + 9u;
+					const size_t end = sig.rfind(">(");
+				#else
+					const size_t begin = std::string::npos;
+					const size_t end = std::string::npos;
+				#endif
+
+					if (begin == std::string::npos || end == std::string::npos || end <= begin)
+						return std::string("unknown");
+
+					return sig.substr(begin, end - begin);
+				}();
+
+				return name.c_str();
+			}
+		}
+
+//}
+
+
+//{ Optimizer
+
+	#if !defined(__GNUC__) && !defined(__clang__)
+
+		namespace Intl
+		{
+			/// Volatile sink used by DoNotOptimize fallback.
+			inline const volatile void* optimizerSink = nullptr;
+		}
+
+	#endif
+
+		template <typename T>
+		void DoNotOptimize(const T& _value)
+		{
+		#if defined(__GNUC__) || defined(__clang__)
+			asm volatile("" : : "r,m"(_value) : "memory");
+		#else
+			Intl::optimizerSink = &_value;
+			ClobberMemory();
+		#endif
+		}
+
+		template <typename T>
+		void DoNotOptimize(T& _value)
+		{
+		#if defined(__clang__)
+			asm volatile("" : "+r,m"(_value) : : "memory");
+		#elif defined(__GNUC__)
+			asm volatile("" : "+m,r"(_value) : : "memory");
+		#else
+			Intl::optimizerSink = &_value;
+			ClobberMemory();
+		#endif
+		}
+
+		void ClobberMemory()
+		{
+		#if defined(__GNUC__) || defined(__clang__)
+			asm volatile("" : : : "memory");
+		#elif _WIN32
+			_ReadWriteBarrier();
+		#else
+			std::atomic_signal_fence(std::memory_order_acq_rel);
+		#endif
+		}
+
+//}
+
+
+//{ Bench
+
+		/// Complexity ToString specialization.
+		template <>
+		inline std::string ToString(const Complexity& _elem)
+		{
+			switch (_elem)
+			{
+				case Complexity::O1:
+					return "O(1)";
+				case Complexity::OLogN:
+					return "O(log n)";
+				case Complexity::ON:
+					return "O(n)";
+				case Complexity::ONLogN:
+					return "O(n log n)";
+				case Complexity::ON2:
+					return "O(n^2)";
+				default:
+					return "O(?)";
+			}
+		}
+
+		std::string BenchEnv::ToString() const
+		{
+			std::string res;
+
+			if (cpu >= 0)
+				res += "cpu " + std::to_string(cpu) + ", ";
+
+			if (bColdCache)
+				res += "cold cache (" + std::to_string(cacheSize / 1024u) + " KiB), ";
+
+			if (bFlushDenormals)
+				res += "FTZ/DAZ, ";
+
+			if (bHighPriority)
+				res += "high priority, ";
+
+			if (res.empty())
+				return "default";
+
+			// Remove last ", ".
+			res.resize(res.size() - 2u);
+
+			return res;
+		}
+
+		void Bench::Fit()
+		{
+			// Complexity models, in Complexity enum order.
+			static double (*const models[])(double) =
+			{
+				[](double) { return 1.0; },
+				[](double _n) { return std::log2(_n); },
+				[](double _n) { return _n; },
+				[](double _n) { return _n * std::log2(_n); },
+				[](double _n) { return _n * _n; },
+			};
+
+			if (samples.empty())
+				return;
+
+			double meanTime = 0.0;
+
+			for (auto it = samples.begin(); it != samples.end(); ++it)
+				meanTime += it->ns;
+
+			meanTime /= samples.size();
+
+			double bestRms = -1.0;
+
+			for (unsigned int i = 0; i < sizeof(models) / sizeof(models[0]); ++i)
+			{
+				// Least squares: minimize sum((t - c * f(n))^2).
+				double sumTF = 0.0;
+				double sumFF = 0.0;
+
+				for (auto it = samples.begin(); it != samples.end(); ++it)
+				{
+					const double f = models[i](static_cast<double>(it->n));
+
+					sumTF += it->ns * f;
+					sumFF += f * f;
+				}
+
+				// Model can't be fitted (ex: log(1) == 0).
+				if (sumFF <= 0.0)
+					continue;
+
+				const double c = sumTF / sumFF;
+				double err = 0.0;
+
+				for (auto it = samples.begin(); it != samples.end(); ++it)
+				{
+					const double diff = it->ns - c * models[i](static_cast<double>(it->n));
+					err += diff * diff;
+				}
+
+				const double currRms = meanTime > 0.0 ? std::sqrt(err / samples.size()) / meanTime : 0.0;
+
+				if (bestRms < 0.0 || currRms < bestRms)
+				{
+					bestRms = currRms;
+					complexity = static_cast<Complexity>(i);
+					coef = c;
+				}
+			}
+
+			rms = bestRms < 0.0 ? 0.0 : bestRms;
+		}
+
+		template <typename SizesT, typename FuncT>
+		Bench Bench::Range(const std::string& _name, const SizesT& _sizes, FuncT&& _body)
+		{
+			Bench bench{ _name };
+
+			const uint64_t traceStart = Timer::Start();
+
+			Intl::BenchEnvScope envScope(benchSettings.env);
+			bench.env = envScope.Applied();
+
+			for (auto it = std::begin(_sizes); it != std::end(_sizes); ++it)
+			{
+				BenchState state;
+				state.n = static_cast<size_t>(*it);
+
+				const uint64_t sampleStart = Timer::Start();
+
+				BenchSample sample = Intl::MeasureBenchSize(_body, state, bench.env);
+
+				if (bTrace)
+					Intl::Trace::instance.Complete(_name, "bench.run", sampleStart, Timer::Stop(), "{\"n\":" + std::to_string(state.n) + '}');
+
+				if (sample.ns > 0.0)
+				{
+					sample.itemsPerSec = (state.items ? state.items : state.n) * 1e9 / sample.ns;
+					sample.bytesPerSec = state.bytes * 1e9 / sample.ns;
+				}
+
+				bench.samples.push_back(sample);
+			}
+
+			bench.Fit();
+
+			if (bTrace)
+				Intl::Trace::instance.Complete(_name, "bench", traceStart, Timer::Stop(), "{\"sizes\":" + std::to_string(bench.samples.size()) + '}');
+
+			Intl::ComputeBench(bench);
+
+			return bench;
+		}
+
+		void Bench::Log(const Bench& _bench)
+		{
+			using namespace Intl;
+
+			LogFlagScope flagScope(Verbosity::BenchResult);
+
+			SetConsoleColor(CslColor::Bench);
+			SA_UTH_LOG("[SA-UTH] Bench:\t" << _bench.name);
+
+			for (auto it = _bench.samples.begin(); it != _bench.samples.end(); ++it)
+			{
+				std::string line = "\tn: " + std::to_string(it->n) +
+					"\ttime: " + FormatDuration(it->ns);
+
+				if (it->runs > 1u)
+				{
+					std::ostringstream ciStr;
+					ciStr << std::fixed << std::setprecision(2) << it->ci * 100.0;
+
+					line += " +/- " + ciStr.str() + "%\truns: " + std::to_string(it->runs);
+				}
+
+				line += "\titer: " + std::to_string(it->iterations) +
+					"\t" + FormatRate(it->itemsPerSec, "items");
+
+				if (it->bytesPerSec > 0.0)
+					line += "\t" + FormatRate(it->bytesPerSec, "B");
+
+				SA_UTH_LOG(line);
+			}
+
+			if (_bench.samples.size() > 1u)
+			{
+				std::ostringstream rmsStr;
+				rmsStr << std::fixed << std::setprecision(1) << _bench.rms * 100.0;
+
+				SA_UTH_LOG("\tComplexity: " << ToString(_bench.complexity) <<
+					"\tcoef: " << FormatDuration(_bench.coef) << "\trms: " << rmsStr.str() << '%');
+			}
+
+			SA_UTH_LOG("\tEnv: " << _bench.env.ToString());
+
+			SetConsoleColor(CslColor::None);
+		}
+
+		bool BenchCompare::IsFaster() const noexcept
+		{
+			return pValue < alpha;
+		}
+
+		template <typename BaseT, typename CandT>
+		BenchCompare BenchCompare::Run(const std::string& _name, BaseT&& _baseline, CandT&& _candidate, double _minSpeedup)
+		{
+			BenchCompare compare{ _name };
+			compare.minSpeedup = _minSpeedup;
+			compare.alpha = benchSettings.compareAlpha;
+
+			const uint64_t traceStart = Timer::Start();
+
+			Intl::BenchEnvScope envScope(benchSettings.env);
+
+			BenchState baseState;
+			BenchState candState;
+
+			// Each body is calibrated for its runs to last runTime.
+			double baseNs = 0.0;
+			double candNs = 0.0;
+
+			const unsigned int baseIt = Intl::CalibrateBenchBody(_baseline, baseState, envScope.Applied(), benchSettings.runTime, baseNs);
+			const unsigned int candIt = Intl::CalibrateBenchBody(_candidate, candState, envScope.Applied(), benchSettings.runTime, candNs);
+
+			std::vector<double> baseRuns;
+			std::vector<double> candRuns;
+
+			baseRuns.reserve(benchSettings.compareRuns);
+			candRuns.reserve(benchSettings.compareRuns);
+
+			// Interleave runs (ABBA order) to cancel drift.
+			for (unsigned int i = 0u; i < benchSettings.compareRuns; ++i)
+			{
+				if (i % 2u == 0u)
+				{
+					baseRuns.push_back(Intl::MeasureBenchBody(_baseline, baseState, baseIt, envScope.Applied()) / baseIt);
+					candRuns.push_back(Intl::MeasureBenchBody(_candidate, candState, candIt, envScope.Applied()) / candIt);
+				}
+				else
+				{
+					candRuns.push_back(Intl::MeasureBenchBody(_candidate, candState, candIt, envScope.Applied()) / candIt);
+					baseRuns.push_back(Intl::MeasureBenchBody(_baseline, baseState, baseIt, envScope.Applied()) / baseIt);
+				}
+			}
+
+			std::sort(baseRuns.begin(), baseRuns.end());
+			std::sort(candRuns.begin(), candRuns.end());
+
+			compare.baseline.iterations = baseIt;
+			compare.baseline.runs = static_cast<unsigned int>(baseRuns.size());
+			compare.baseline.ci = Intl::MedianCI(baseRuns, compare.baseline.ns);
+
+			compare.candidate.iterations = candIt;
+			compare.candidate.runs = static_cast<unsigned int>(candRuns.size());
+			compare.candidate.ci = Intl::MedianCI(candRuns, compare.candidate.ns);
+
+			if (compare.candidate.ns > 0.0)
+				compare.speedup = compare.baseline.ns / compare.candidate.ns - 1.0;
+
+			// Candidate at least minSpeedup faster: candidate < baseline / (1 + minSpeedup).
+			for (auto it = baseRuns.begin(); it != baseRuns.end(); ++it)
+				*it /= 1.0 + _minSpeedup;
+
+			compare.pValue = Intl::MannWhitneyU(candRuns, baseRuns);
+
+			if (bTrace)
+				Intl::Trace::instance.Complete(_name, "bench", traceStart, Timer::Stop(), "{\"runs\":" + std::to_string(benchSettings.compareRuns) + '}');
+
+			if (Intl::ShouldLog(Verbosity::BenchResult))
+				Log(compare);
+
+			return compare;
+		}
+
+		void BenchCompare::Log(const BenchCompare& _compare)
+		{
+			using namespace Intl;
+
+			LogFlagScope flagScope(Verbosity::BenchResult);
+
+			SetConsoleColor(CslColor::Bench);
+			SA_UTH_LOG("[SA-UTH] Bench:\t" << _compare.name);
+
+			std::ostringstream baseCI;
+			baseCI << std::fixed << std::setprecision(2) << _compare.baseline.ci * 100.0;
+
+			std::ostringstream candCI;
+			candCI << std::fixed << std::setprecision(2) << _compare.candidate.ci * 100.0;
+
+			SA_UTH_LOG("\tbaseline:\t" << FormatDuration(_compare.baseline.ns) << " +/- " << baseCI.str() <<
+				"%\truns: " << _compare.baseline.runs << "\titer: " << _compare.baseline.iterations);
+
+			SA_UTH_LOG("\tcandidate:\t" << FormatDuration(_compare.candidate.ns) << " +/- " << candCI.str() <<
+				"%\truns: " << _compare.candidate.runs << "\titer: " << _compare.candidate.iterations);
+
+			std::ostringstream result;
+			result << std::fixed << std::setprecision(1) << "\tspeedup: " << _compare.speedup * 100.0 <<
+				"%\trequired: " << _compare.minSpeedup * 100.0 << '%' <<
+				std::defaultfloat << std::setprecision(3) << "\tp: " << _compare.pValue;
+
+			SA_UTH_LOG(result.str());
+
+			SetConsoleColor(CslColor::None);
+		}
+
+		bool BenchScaling::IsScaling() const noexcept
+		{
+			return samples.empty() || samples.back().speedup >= minSpeedup;
+		}
+
+		template <typename FuncT>
+		BenchScaling BenchScaling::Run(const std::string& _name, unsigned int _maxThreads, FuncT&& _body, double _minSpeedup)
+		{
+			BenchScaling scaling{ _name };
+			scaling.minSpeedup = _minSpeedup;
+
+			if (_maxThreads == 0u)
+				_maxThreads = 1u;
+
+			// Calibrate calls per thread on a single thread.
+			unsigned int iterations = 0u;
+			size_t items = 1u;
+
+			{
+				Intl::BenchEnvScope envScope(benchSettings.env);
+
+				BenchState state;
+				double ns = 0.0;
+
+				iterations = Intl::CalibrateBenchBody(_body, state, envScope.Applied(), benchSettings.minTime, ns);
+
+				if (state.items)
+					items = state.items;
+			}
+
+			double singleThroughput = 0.0;
+
+			for (unsigned int threads = 1u; ; threads = threads * 2u < _maxThreads ? threads * 2u : _maxThreads)
+			{
+				std::atomic<unsigned int> ready{ 0u };
+				std::atomic<bool> bStart{ false };
+				std::vector<uint64_t> ends(threads);
+				std::vector<std::thread> workers;
+
+				workers.reserve(threads);
+
+				for (unsigned int i = 0u; i < threads; ++i)
+				{
+					workers.emplace_back([&, i]()
+					{
+						// Apply environment per thread: pin each worker to its own CPU.
+						BenchEnv env = benchSettings.env;
+
+						if (env.cpu >= 0)
+							env.cpu += static_cast<int>(i);
+
+						Intl::BenchEnvScope envScope(env);
+
+						BenchState state;
+						state.thread = i;
+						state.threadCount = threads;
+
+						// Barrier: wait for every thread before starting.
+						ready.fetch_add(1u);
+
+						while (!bStart.load(std::memory_order_acquire))
+							std::this_thread::yield();
+
+						const uint64_t threadStart = Timer::Start();
+
+						Intl::MeasureBenchBody(_body, state, iterations, envScope.Applied());
+
+						ends[i] = Timer::Stop();
+
+						// Each worker on its own trace thread.
+						if (bTrace)
+						{
+							Intl::Trace::instance.Complete(_name, "bench.run", threadStart, ends[i],
+								"{\"threads\":" + std::to_string(threads) + '}');
+						}
+					});
+				}
+
+				while (ready.load() != threads)
+					std::this_thread::yield();
+
+				const uint64_t start = Timer::Start();
+				bStart.store(true, std::memory_order_release);
+
+				for (auto it = workers.begin(); it != workers.end(); ++it)
+					it->join();
+
+				const uint64_t end = *std::max_element(ends.begin(), ends.end());
+
+				BenchThreadSample sample;
+				sample.threads = threads;
+				sample.ns = Timer::Elapsed(start, end) / iterations;
+
+				if (sample.ns > 0.0)
+					sample.itemsPerSec = static_cast<double>(threads) * items * 1e9 / sample.ns;
+
+				if (threads == 1u)
+					singleThroughput = sample.itemsPerSec;
+
+				if (singleThroughput > 0.0)
+				{
+					sample.speedup = sample.itemsPerSec / singleThroughput;
+					sample.efficiency = sample.speedup / threads;
+				}
+
+				scaling.samples.push_back(sample);
+
+				if (threads == _maxThreads)
+					break;
+			}
+
+			if (Intl::ShouldLog(Verbosity::BenchResult))
+				Log(scaling);
+
+			return scaling;
+		}
+
+		void BenchScaling::Log(const BenchScaling& _scaling)
+		{
+			using namespace Intl;
+
+			LogFlagScope flagScope(Verbosity::BenchResult);
+
+			SetConsoleColor(CslColor::Bench);
+			SA_UTH_LOG("[SA-UTH] Bench:\t" << _scaling.name);
+
+			for (auto it = _scaling.samples.begin(); it != _scaling.samples.end(); ++it)
+			{
+				std::ostringstream line;
+				line << "\tthreads: " << it->threads <<
+					"\ttime: " << FormatDuration(it->ns) <<
+					"\t" << FormatRate(it->itemsPerSec, "items") <<
+					std::fixed << std::setprecision(2) << "\tspeedup: " << it->speedup <<
+					std::setprecision(1) << "\tefficiency: " << it->efficiency * 100.0 << '%';
+
+				SA_UTH_LOG(line.str());
+			}
+
+			SetConsoleColor(CslColor::None);
+		}
+
+//}
+
+
+//{ Latency
+
+		Histogram::Histogram() : counts(bucketCount, 0u)
+		{
+		}
+
+		size_t Histogram::Index(uint64_t _value) noexcept
+		{
+			// Exact values.
+			if (_value < subCount)
+				return static_cast<size_t>(_value);
+
+			// Log-linear: keep subBits significant bits.
+			const unsigned int shift = Intl::HighestBit(_value) - subBits + 1u;
+
+			return shift * halfCount + static_cast<size_t>(_value >> shift);
+		}
+
+		uint64_t Histogram::HighestValue(size_t _index) noexcept
+		{
+			if (_index < subCount)
+				return _index;
+
+			const unsigned int shift = static_cast<unsigned int>(_index / halfCount) - 1u;
+			const uint64_t sub = _index % halfCount + halfCount;
+
+			return ((sub + 1u) << shift) - 1u;
+		}
+
+		void Histogram::Record(uint64_t _value) noexcept
+		{
+			++counts[Index(_value)];
+			++total;
+
+			sum += static_cast<double>(_value);
+
+			if (_value < min)
+				min = _value;
+
+			if (_value > max)
+				max = _value;
+		}
+
+		void Histogram::Reset() noexcept
+		{
+			std::fill(counts.begin(), counts.end(), 0u);
+
+			total = 0u;
+			min = ~uint64_t(0u);
+			max = 0u;
+			sum = 0.0;
+		}
+
+		uint64_t Histogram::Count() const noexcept
+		{
+			return total;
+		}
+
+		uint64_t Histogram::Min() const noexcept
+		{
+			return total ? min : 0u;
+		}
+
+		uint64_t Histogram::Max() const noexcept
+		{
+			return max;
+		}
+
+		double Histogram::Mean() const noexcept
+		{
+			return total ? sum / total : 0.0;
+		}
+
+		uint64_t Histogram::Percentile(double _percentile) const noexcept
+		{
+			if (total == 0u)
+				return 0u;
+
+			// Rank of the value at percentile (1-based).
+			uint64_t rank = static_cast<uint64_t>(std::ceil(_percentile / 100.0 * total));
+
+			if (rank == 0u)
+				rank = 1u;
+
+			uint64_t accumulated = 0u;
+
+			for (size_t i = 0u; i < counts.size(); ++i)
+			{
+				accumulated += counts[i];
+
+				if (accumulated >= rank)
+				{
+					// Bucket upper bound can't exceed the real max.
+					const uint64_t value = HighestValue(i);
+					return value < max ? value : max;
+				}
+			}
+
+			return max;
+		}
+
+		Histogram& Histogram::operator+=(const Histogram& _rhs) noexcept
+		{
+			for (size_t i = 0u; i < counts.size(); ++i)
+				counts[i] += _rhs.counts[i];
+
+			total += _rhs.total;
+			sum += _rhs.sum;
+
+			if (_rhs.min < min)
+				min = _rhs.min;
+
+			if (_rhs.max > max)
+				max = _rhs.max;
+
+			return *this;
+		}
+
+
+		template <typename FuncT>
+		Latency Latency::Run(const std::string& _name, FuncT&& _op, size_t _count)
+		{
+			Latency latency{ _name };
+
+			const uint64_t traceStart = Timer::Start();
+
+			Intl::BenchEnvScope envScope(benchSettings.env);
+
+			BenchState state;
+
+			for (size_t i = 0u; i < _count; ++i)
+			{
+				state.n = i;
+
+				if (envScope.Applied().bColdCache)
+					Intl::FlushCache(envScope.Applied().cacheSize);
+
+				const uint64_t start = Timer::Start();
+
+				Intl::RunBenchBody(_op, state);
+				ClobberMemory();
+
+				const uint64_t stop = Timer::Stop();
+
+				latency.histogram.Record(static_cast<uint64_t>(Timer::Elapsed(start, stop) + 0.5));
+			}
+
+			if (bTrace)
+				Intl::Trace::instance.Complete(_name, "bench", traceStart, Timer::Stop(), "{\"count\":" + std::to_string(_count) + '}');
+
+			if (Intl::ShouldLog(Verbosity::BenchResult))
+				Log(latency);
+
+			return latency;
+		}
+
+		void Latency::Log(const Latency& _latency)
+		{
+			using namespace Intl;
+
+			LogFlagScope flagScope(Verbosity::BenchResult);
+
+			const Histogram& hist = _latency.histogram;
+
+			SetConsoleColor(CslColor::Bench);
+			SA_UTH_LOG("[SA-UTH] Latency:\t" << _latency.name);
+
+			SA_UTH_LOG("\tcount: " << hist.Count() <<
+				"\tmin: " << FormatDuration(static_cast<double>(hist.Min())) <<
+				"\tmean: " << FormatDuration(hist.Mean()) <<
+				"\tmax: " << FormatDuration(static_cast<double>(hist.Max())));
+
+			SA_UTH_LOG("\tp50: " << FormatDuration(static_cast<double>(hist.Percentile(50.0))) <<
+				"\tp90: " << FormatDuration(static_cast<double>(hist.Percentile(90.0))) <<
+				"\tp99: " << FormatDuration(static_cast<double>(hist.Percentile(99.0))) <<
+				"\tp99.9: " << FormatDuration(static_cast<double>(hist.Percentile(99.9))));
+
+			SetConsoleColor(CslColor::None);
+		}
+
+//}
+
+
+//{ Profiler
+
+		namespace Intl
+		{
+		#if SA_UTH_BACKTRACE
+			/// SIGPROF handler: async-signal-safe capture in preallocated buffer.
+			inline void ProfileSignal(int)
+			{
+				const int savedErrno = errno;
+
+				const size_t index = profileState.count.fetch_add(1u, std::memory_order_relaxed);
+
+				if (index < Profiler::capacity)
+				{
+					ProfileSample& sample = profileState.samples[index];
+
+					sample.group = profileState.group.load(std::memory_order_relaxed);
+					sample.depth = backtrace(sample.frames, static_cast<int>(Profiler::maxFrames));
+				}
+
+				errno = savedErrno;
+			}
+		#endif
+
+			void ProfileGroupBegin(const std::string& _name)
+			{
+				ProfileState& state = profileState;
+
+				if (!state.bRunning)
+					return;
+
+				const uint32_t parent = state.group.load(std::memory_order_relaxed);
+				const std::string path = (parent ? state.groups[parent] + ';' : std::string()) + _name;
+
+				auto it = std::find(state.groups.begin(), state.groups.end(), path);
+
+				if (it == state.groups.end())
+				{
+					state.groups.push_back(path);
+					it = state.groups.end() - 1;
+				}
+
+				state.groupStack.push_back(parent);
+				state.group.store(static_cast<uint32_t>(it - state.groups.begin()), std::memory_order_relaxed);
+			}
+
+			void ProfileGroupEnd()
+			{
+				ProfileState& state = profileState;
+
+				if (state.groupStack.empty())
+					return;
+
+				state.group.store(state.groupStack.back(), std::memory_order_relaxed);
+				state.groupStack.pop_back();
+			}
+
+			std::string SymbolName(void* _address)
+			{
+			#if SA_UTH_BACKTRACE
+				char** symbols = backtrace_symbols(&_address, 1);
+
+				if (!symbols)
+					return "[unknown]";
+
+				// glibc format: binary(mangled+0x1a) [0x...]
+				std::string res = symbols[0];
+				free(symbols);
+
+				const size_t begin = res.find('(');
+				const size_t end = res.find_first_of("+)", begin);
+
+				if (begin != std::string::npos && end != std::string::npos && end > begin + 1u)
+				{
+					const std::string mangled = res.substr(begin + 1u, end - begin - 1u);
+
+					int status = 0;
+					char* demangled = abi::__cxa_demangle(mangled.c_str(), nullptr, nullptr, &status);
+
+					if (status == 0 && demangled)
+					{
+						res = demangled;
+						free(demangled);
+					}
+					else
+						res = mangled;
+				}
+				else if (begin != std::string::npos)
+				{
+					// Unexported symbol: keep binary name and offset.
+					const size_t slash = res.rfind('/', begin);
+					const size_t close = res.find(')', begin);
+
+					res = res.substr(slash == std::string::npos ? 0u : slash + 1u, begin - (slash == std::string::npos ? 0u : slash + 1u)) +
+						res.substr(begin + 1u, close == std::string::npos ? std::string::npos : close - begin - 1u);
+				}
+
+				// ';' is the folded stack separator.
+				std::replace(res.begin(), res.end(), ';', ':');
+
+				return res;
+			#else
+				(void)_address;
+
+				return "[unknown]";
+			#endif
+			}
+		}
+
+		bool Profiler::Start(unsigned int _frequency)
+		{
+			using namespace Intl;
+
+			ProfileState& state = profileState;
+
+			if (state.bRunning)
+				return true;
+
+		#if SA_UTH_BACKTRACE
+			if (!state.samples)
+				state.samples = std::make_unique<ProfileSample[]>(capacity);
+
+			// First backtrace call loads the unwinder (not async-signal-safe).
+			void* warmup[1];
+			backtrace(warmup, 1);
+
+			struct sigaction action{};
+			action.sa_handler = ProfileSignal;
+			action.sa_flags = SA_RESTART;
+			sigemptyset(&action.sa_mask);
+
+			if (sigaction(SIGPROF, &action, &state.oldAction) != 0)
+				return false;
+
+			const long period = 1000000000L / static_cast<long>(_frequency ? _frequency : 1u);
+
+		#if __linux__
+			sigevent event{};
+			event.sigev_notify = SIGEV_SIGNAL;
+			event.sigev_signo = SIGPROF;
+
+			if (timer_create(CLOCK_PROCESS_CPUTIME_ID, &event, &state.timer) != 0)
+			{
+				sigaction(SIGPROF, &state.oldAction, nullptr);
+				return false;
+			}
+
+			itimerspec spec{};
+			spec.it_interval.tv_sec = period / 1000000000L;
+			spec.it_interval.tv_nsec = period % 1000000000L;
+			spec.it_value = spec.it_interval;
+
+			timer_settime(state.timer, 0, &spec, nullptr);
+		#else
+			itimerval spec{};
+			spec.it_interval.tv_sec = period / 1000000000L;
+			spec.it_interval.tv_usec = (period % 1000000000L) / 1000L;
+			spec.it_value = spec.it_interval;
+
+			setitimer(ITIMER_PROF, &spec, nullptr);
+		#endif
+
+			state.bRunning = true;
+
+			return true;
+		#else
+			(void)_frequency;
+
+			SetConsoleColor(CslColor::ParamWarning);
+			SA_UTH_LOG("[SA-UTH] Profiler not supported on this platform.");
+			SetConsoleColor(CslColor::None);
+
+			return false;
+		#endif
+		}
+
+		void Profiler::Stop()
+		{
+			using namespace Intl;
+
+			ProfileState& state = profileState;
+
+			if (!state.bRunning)
+				return;
+
+		#if SA_UTH_BACKTRACE
+		#if __linux__
+			timer_delete(state.timer);
+		#else
+			itimerval spec{};
+			setitimer(ITIMER_PROF, &spec, nullptr);
+		#endif
+
+			sigaction(SIGPROF, &state.oldAction, nullptr);
+		#endif
+
+			state.bRunning = false;
+		}
+
+		bool Profiler::IsRunning() noexcept
+		{
+			return Intl::profileState.bRunning;
+		}
+
+		std::string Profiler::Write()
+		{
+			using namespace Intl;
+
+			ProfileState& state = profileState;
+
+			const size_t count = (std::min)(state.count.load(), capacity);
+
+			if (count == 0u)
+				return std::string();
+
+			// Symbolize each address once.
+			std::unordered_map<void*, std::string> symbols;
+
+			auto symbol = [&symbols](void* _address) -> const std::string&
+			{
+				auto it = symbols.find(_address);
+
+				// Return address points after the call instruction.
+				if (it == symbols.end())
+					it = symbols.emplace(_address, SymbolName(static_cast<char*>(_address) - 1)).first;
+
+				return it->second;
+			};
+
+			// Fold identical symbolized stacks.
+			std::unordered_map<std::string, uint64_t> stacks;
+
+			for (size_t i = 0u; i < count; ++i)
+			{
+				const ProfileSample& sample = state.samples[i];
+
+				std::string stack = state.groups[sample.group];
+
+				// Root first, skip signal handler and signal trampoline frames.
+				for (int j = sample.depth - 1; j >= 2; --j)
+					stack += ';' + symbol(sample.frames[j]);
+
+				++stacks[stack];
+			}
+
+			std::filesystem::create_directories("Logs");
+
+			// profile_UTH-<month>.<day>.<year>-<hour>h<minute>m<second>s.folded
+			const std::string fileName = std::string("Logs/profile_UTH-") + DateStr() + ".folded";
+			std::ofstream file(fileName, std::ios::out | std::ios::trunc);
+
+			for (auto it = stacks.begin(); it != stacks.end(); ++it)
+				file << it->first << ' ' << it->second << '\n';
+
+			return fileName;
+		}
+
+//}
+
+
+//{ Stats
+
+		bool StatsPage::Open(const std::string& _path)
+		{
+			using namespace Intl;
+
+			if (statsData)
+				return true;
+
+		#if _WIN32
+			(void)_path;
+			return false;
+		#else
+			std::string path = _path;
+			std::error_code error;
+
+			if (path.empty())
+			{
+				StatsFile::RemoveStale();
+
+				if (std::filesystem::is_directory("/dev/shm", error))
+					path = "/dev/shm/sa_uth-" + std::to_string(getpid());
+				else
+				{
+					std::filesystem::create_directories("Logs", error);
+					path = "Logs/stats_UTH-" + std::to_string(getpid()) + ".shm";
+				}
+			}
+
+			const int fd = open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+
+			if (fd < 0)
+				return false;
+
+			if (ftruncate(fd, sizeof(StatsData)) != 0)
+			{
+				close(fd);
+				unlink(path.c_str());
+				return false;
+			}
+
+			void* const map = mmap(nullptr, sizeof(StatsData), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+			close(fd);
+
+			if (map == MAP_FAILED)
+			{
+				unlink(path.c_str());
+				return false;
+			}
+
+			StatsData* const data = new(map) StatsData{};
+			data->pid = static_cast<int64_t>(getpid());
+			data->startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+			data->success.store(globalCount.success, std::memory_order_relaxed);
+			data->failure.store(globalCount.failure, std::memory_order_relaxed);
+
+			statsPath = path;
+			statsData = data;
+
+			StatsGroup();
+
+			return true;
+		#endif
+		}
+
+		void StatsPage::Close()
+		{
+			using namespace Intl;
+
+			if (!statsData)
+				return;
+
+		#if !_WIN32
+			statsData->state.store(1u, std::memory_order_release);
+
+			munmap(statsData, sizeof(StatsData));
+			unlink(statsPath.c_str());
+		#endif
+
+			statsData = nullptr;
+		}
+
+		bool StatsPage::IsOpen() noexcept
+		{
+			return Intl::statsData != nullptr;
+		}
+
+		const std::string& StatsPage::Path() noexcept
+		{
+			return Intl::statsPath;
+		}
+
+
+		namespace Intl
+		{
+			void StatsRecord(bool _pred) noexcept
+			{
+				StatsData* const data = statsData;
+
+				if (!data)
+					return;
+
+				// Mirror of globalCount: no read-modify-write on shared cache line.
+				data->success.store(globalCount.success, std::memory_order_relaxed);
+				data->failure.store(globalCount.failure, std::memory_order_relaxed);
+
+				thread_local StatsData* workerData = nullptr;
+				thread_local StatsWorker* worker = nullptr;
+				thread_local uint32_t workerPath = static_cast<uint32_t>(-1);
+
+				if (workerData != data)
+				{
+					const unsigned int tid = ThreadIndex();
+
+					worker = &data->workers[tid % StatsData::maxWorkers];
+					worker->tid.store(tid + 1u, std::memory_order_relaxed);
+
+					workerData = data;
+					workerPath = static_cast<uint32_t>(-1);
+				}
+
+				(_pred ? worker->success : worker->failure).fetch_add(1u, std::memory_order_relaxed);
+
+				const uint32_t path = ThreadLog::CurrentPathId();
+
+				if (path != workerPath)
+				{
+					worker->pathId.store(path, std::memory_order_relaxed);
+					workerPath = path;
+				}
+			}
+
+			void StatsGroup()
+			{
+				StatsData* const data = statsData;
+
+				if (!data)
+					return;
+
+				const uint32_t id = ThreadLog::CurrentPathId();
+
+				if (id)
+				{
+					StatsPath& entry = data->paths[id % StatsData::maxPaths];
+
+					if (entry.id.load(std::memory_order_relaxed) != id)
+					{
+						const std::string name = ThreadLog::PathName(id);
+						const size_t size = (std::min)(name.size(), sizeof(entry.name) - 1u);
+
+						const uint32_t seq = entry.seq.load(std::memory_order_relaxed);
+						entry.seq.store(seq + 1u, std::memory_order_relaxed);
+						std::atomic_thread_fence(std::memory_order_release);
+
+						entry.id.store(id, std::memory_order_relaxed);
+						memcpy(entry.name, name.data(), size);
+						entry.name[size] = '\0';
+
+						entry.seq.store(seq + 2u, std::memory_order_release);
+					}
+				}
+
+				data->pathId.store(id, std::memory_order_relaxed);
+
+				data->groupSuccess.store(Group::globalCount.success, std::memory_order_relaxed);
+				data->groupFailure.store(Group::globalCount.failure, std::memory_order_relaxed);
+			}
+		}
+
+//}
+
+
+//{ Progress
+
+		bool Progress::Start()
+		{
+			using namespace Intl;
+
+			if (progress.bRunning.load())
+				return true;
+
+		#if _WIN32
+			if (!_isatty(_fileno(stdout)))
+				return false;
+		#else
+			if (!isatty(STDOUT_FILENO))
+				return false;
+		#endif
+
+			progress.history.clear();
+			progress.durations.clear();
+			progress.matchedHistory = 0.0;
+			progress.matchedActual = 0.0;
+
+			{
+				// "<duration in ns>\t<group name>" per line.
+				std::ifstream file(ProgressHistoryFile());
+
+				for (std::string line; std::getline(file, line);)
+				{
+					const size_t tab = line.find('\t');
+
+					if (tab == std::string::npos)
+						continue;
+
+					ProgressEntry entry{ line.substr(tab + 1u), std::strtod(line.c_str(), nullptr) };
+					progress.history.push_back(std::move(entry));
+				}
+			}
+
+			progress.historyDone.assign(progress.history.size(), false);
+
+			progress.bStop = false;
+			progress.bPaused = false;
+			progress.bLineStart = true;
+			progress.drawnSize = 0u;
+			progress.groupBeginTicks = 0u;
+			progress.groupHistory = static_cast<size_t>(-1);
+
+			progress.rate = 0.0;
+			progress.rateTests = globalCount.Total();
+			progress.rateTime = std::chrono::steady_clock::now();
+
+			std::cout.flush();
+			progress.buffer.out = std::cout.rdbuf(&progress.buffer);
+
+			progress.bRunning.store(true);
+			ProgressRecord();
+
+			progress.timer = std::thread([]()
+			{
+				std::unique_lock<std::mutex> lock(progress.mutex);
+
+				while (!progress.cv.wait_for(lock, std::chrono::milliseconds(period), []() { return progress.bStop; }))
+					ProgressDraw();
+			});
+
+			return true;
+		}
+
+		void Progress::Stop()
+		{
+			using namespace Intl;
+
+			if (!progress.bRunning.load())
+				return;
+
+			{
+				std::lock_guard<std::mutex> lock(progress.mutex);
+
+				progress.bStop = true;
+				ProgressErase();
+			}
+
+			progress.cv.notify_all();
+			progress.timer.join();
+
+			std::cout.flush();
+			std::cout.rdbuf(progress.buffer.out);
+
+			progress.bRunning.store(false);
+
+			if (!progress.durations.empty())
+			{
+				std::error_code error;
+				std::filesystem::create_directories("Logs", error);
+
+				std::ofstream file(ProgressHistoryFile(), std::ios::out | std::ios::trunc);
+
+				for (auto it = progress.durations.begin(); it != progress.durations.end(); ++it)
+					file << it->time << '\t' << it->name << '\n';
+			}
+		}
+
+		bool Progress::IsRunning() noexcept
+		{
+			return Intl::progress.bRunning.load(std::memory_order_relaxed);
+		}
+
+
+		namespace Intl
+		{
+			int ProgressBuf::overflow(int _c)
+			{
+				if (traits_type::eq_int_type(_c, traits_type::eof()))
+					return traits_type::not_eof(_c);
+
+				std::lock_guard<std::mutex> lock(progress.mutex);
+
+				ProgressErase();
+				progress.bLineStart = _c == '\n';
+
+				return out->sputc(traits_type::to_char_type(_c));
+			}
+
+			std::streamsize ProgressBuf::xsputn(const char* _str, std::streamsize _size)
+			{
+				if (_size <= 0)
+					return 0;
+
+				std::lock_guard<std::mutex> lock(progress.mutex);
+
+				ProgressErase();
+				progress.bLineStart = _str[_size - 1] == '\n';
+
+				return out->sputn(_str, _size);
+			}
+
+			int ProgressBuf::sync()
+			{
+				std::lock_guard<std::mutex> lock(progress.mutex);
+
+				return out->pubsync();
+			}
+
+
+			void ProgressRecord() noexcept
+			{
+				if (!progress.bRunning.load(std::memory_order_relaxed))
+					return;
+
+				progress.success.store(globalCount.success, std::memory_order_relaxed);
+				progress.failure.store(globalCount.failure, std::memory_order_relaxed);
+			}
+
+			std::string ProgressHistoryFile()
+			{
+				std::string exe;
+
+			#if _WIN32
+				char path[MAX_PATH];
+				const DWORD size = GetModuleFileNameA(nullptr, path, MAX_PATH);
+
+				if (size > 0u && size < MAX_PATH)
+					exe = std::filesystem::path(std::string(path, size)).stem().string();
+			#elif __linux__
+				std::error_code error;
+				exe = std::filesystem::read_symlink("/proc/self/exe", error).filename().string();
+			#endif
+
+				return exe.empty() ? "Logs/progress_UTH.txt" : "Logs/progress_UTH-" + exe + ".txt";
+			}
+
+			size_t ProgressFindHistory(const std::string& _name)
+			{
+				for (size_t i = 0u; i < progress.history.size(); ++i)
+				{
+					if (!progress.historyDone[i] && progress.history[i].name == _name)
+						return i;
+				}
+
+				return static_cast<size_t>(-1);
+			}
+
+			void ProgressGroup(bool _bBegin, const std::string& _name, double _time)
+			{
+				if (!progress.bRunning.load(std::memory_order_relaxed))
+					return;
+
+				// Results of process isolated groups are added on end.
+				ProgressRecord();
+
+				std::lock_guard<std::mutex> lock(progress.mutex);
+
+				if (_bBegin)
+				{
+					progress.groupBeginTicks = Timer::Start();
+
+					// Repeated names match entries in run order.
+					progress.groupHistory = ProgressFindHistory(_name);
+				}
+				else
+				{
+					if (progress.groupHistory < progress.history.size())
+					{
+						progress.historyDone[progress.groupHistory] = true;
+						progress.matchedHistory += progress.history[progress.groupHistory].time;
+						progress.matchedActual += _time;
+					}
+
+					progress.groupBeginTicks = 0u;
+					progress.groupHistory = static_cast<size_t>(-1);
+					progress.durations.push_back(ProgressEntry{ _name, _time });
+				}
+			}
+
+			void ProgressPause(bool _bPause)
+			{
+				if (!progress.bRunning.load(std::memory_order_relaxed))
+					return;
+
+				std::lock_guard<std::mutex> lock(progress.mutex);
+
+				ProgressErase();
+				progress.buffer.out->pubsync();
+
+				progress.bPaused = _bPause;
+			}
+
+			void ProgressDetach() noexcept
+			{
+				if (!progress.bRunning.load(std::memory_order_relaxed))
+					return;
+
+				std::cout.rdbuf(progress.buffer.out);
+				progress.bRunning.store(false, std::memory_order_relaxed);
+			}
+
+			void ProgressErase()
+			{
+				if (!progress.drawnSize)
+					return;
+
+				const std::string blank = '\r' + std::string(progress.drawnSize, ' ') + '\r';
+				progress.buffer.out->sputn(blank.data(), static_cast<std::streamsize>(blank.size()));
+
+				progress.drawnSize = 0u;
+			}
+
+			void ProgressDraw()
+			{
+				// Never break a line being written.
+				if (progress.bPaused || !progress.bLineStart)
+					return;
+
+				std::string line = ProgressLine();
+
+				// Stay on a single console line.
+				if (line.size() > 79u)
+					line.resize(79u);
+
+				ProgressErase();
+
+				progress.buffer.out->sputn(line.data(), static_cast<std::streamsize>(line.size()));
+				progress.buffer.out->pubsync();
+
+				progress.drawnSize = line.size();
+			}
+
+			std::string ProgressLine()
+			{
+				const uint64_t failure = progress.failure.load(std::memory_order_relaxed);
+				const uint64_t tests = progress.success.load(std::memory_order_relaxed) + failure;
+
+				const auto now = std::chrono::steady_clock::now();
+				const double rateSeconds = std::chrono::duration<double>(now - progress.rateTime).count();
+
+				if (rateSeconds >= 0.5)
+				{
+					progress.rate = tests >= progress.rateTests ? (tests - progress.rateTests) / rateSeconds : 0.0;
+					progress.rateTests = tests;
+					progress.rateTime = now;
+				}
+
+				const size_t done = progress.durations.size();
+
+				// Groups of the previous run not run yet (the running one included if matched).
+				size_t pending = 0u;
+				double remaining = 0.0;
+
+				for (size_t i = 0u; i < progress.history.size(); ++i)
+				{
+					if (!progress.historyDone[i])
+					{
+						++pending;
+						remaining += progress.history[i].time;
+					}
+				}
+
+				const bool bRunningUnknown = progress.groupBeginTicks && progress.groupHistory >= progress.history.size();
+				const size_t total = done + pending + (bRunningUnknown ? 1u : 0u);
+
+				std::ostringstream line;
+				line << "[SA-UTH] Groups " << done << '/';
 
-			for (unsigned int i = 0; i < size; ++i)
-				res += ToString(_elems[i]) + "; ";
+				if (progress.history.empty())
+					line << '?';
+				else
+					line << total;
 
-			res[res.size() - 2] = ' ';
-			res[res.size() - 1] = '}';
+				line << " | " << FormatRate(progress.rate, "assert") << " | " << failure << " failed | ETA ";
 
-			return res;
+				if (pending)
+				{
+					// Scale history by the speed of this run (matched groups only).
+					const double scale = progress.matchedHistory > 0.0 ? progress.matchedActual / progress.matchedHistory : 1.0;
+
+					remaining *= scale;
+
+					if (progress.groupBeginTicks && !bRunningUnknown)
+					{
+						remaining -= (std::min)(Timer::Elapsed(progress.groupBeginTicks, Timer::Stop()),
+							progress.history[progress.groupHistory].time * scale);
+					}
+
+					const unsigned long long seconds = static_cast<unsigned long long>((std::max)(remaining, 0.0) / 1e9 + 0.5);
+
+					line << seconds / 3600u << ':' << std::setfill('0') <<
+						std::setw(2) << seconds / 60u % 60u << ':' << std::setw(2) << seconds % 60u;
+				}
+				else
+					line << '?';
+
+				return line.str();
+			}
 		}
 
 //}
 
 
-//{ Equals
+//{ Callback
 
-		/**
-		*	\brief Helper Equals function.
-		*
-		*	\tparam T		Type of operands.
-		*
-		*	\param[in] _lhs		Left hand side operand to compare.
-		*	\param[in] _rhs		Right hand side operand to compare.
-		*
-		*	\return	True on equality, otherwise false.
-		*/
-		template <typename T>
-		bool Equals(const T& _lhs, const T& _rhs)
+		void AddListener(Listener& _listener, unsigned int _events)
 		{
-			return _lhs == _rhs;
+			auto it = std::find_if(Intl::listeners.begin(), Intl::listeners.end(),
+				[&_listener](const Intl::ListenerEntry& _entry) { return _entry.listener == &_listener; });
+
+			if (it != Intl::listeners.end())
+				it->events = _events;
+			else
+				Intl::listeners.push_back(Intl::ListenerEntry{ &_listener, _events });
+
+			Intl::listenerEvents = Event::None;
+
+			for (auto entryIt = Intl::listeners.begin(); entryIt != Intl::listeners.end(); ++entryIt)
+				Intl::listenerEvents |= entryIt->events;
 		}
 
-		/**
-		*	\brief Helper Equals function using epsilon.
-		*
-		*	\tparam T		Type of operands.
-		*
-		*	\param[in] _lhs		Left hand side operand to compare.
-		*	\param[in] _rhs		Right hand side operand to compare.
-		*	\param[in] _epsilon	Epsilon value for threshold compare.
-		*
-		*	\return	True on equality, otherwise false.
-		*/
-		template <typename T>
-		bool Equals(const T& _lhs, const T& _rhs, const T& _epsilon)
+		void RemoveListener(Listener& _listener)
 		{
-			return std::abs(_lhs - _rhs) < _epsilon;
+			Intl::listeners.erase(std::remove_if(Intl::listeners.begin(), Intl::listeners.end(),
+				[&_listener](const Intl::ListenerEntry& _entry) { return _entry.listener == &_listener; }), Intl::listeners.end());
+
+			Intl::listenerEvents = Event::None;
+
+			for (auto it = Intl::listeners.begin(); it != Intl::listeners.end(); ++it)
+				Intl::listenerEvents |= it->events;
 		}
 
-		/**
-		*	\brief Helper Equals function for tab.
-		*
-		*	\tparam T		Type of operands.
-		*
-		*	\param[in] _lhs		Left hand side operand to compare.
-		*	\param[in] _rhs		Right hand side operand to compare.
-		*	\param[in] _size	Size of tabs to compare compare.
-		*
-		*	\return	True on equality, otherwise false.
-		*/
-		template <typename T>
-		bool Equals(const T* _lhs, const T* _rhs, unsigned int _size)
+		namespace Intl
 		{
-			for (unsigned int i = 0; i < _size; ++i)
+			template <typename FuncT>
+			void Notify(unsigned int _event, FuncT&& _func)
 			{
-				if (!Equals(_lhs[i], _rhs[i]))
-					return false;
+				// No subscriber: single flag check.
+				if (!(listenerEvents & _event))
+					return;
+
+				for (auto it = listeners.begin(); it != listeners.end(); ++it)
+				{
+					if (it->events & _event)
+						_func(*it->listener);
+				}
 			}
+		}
 
-			return true;
+//}
+
+
+//{ Compute
+
+		const char* TestSite::FileName() const noexcept
+		{
+			return filePath ? Intl::GetFileNameFromPath(filePath) : "";
 		}
 
-		/**
-		*	\brief Helper Equals function for tab using epsilon.
-		*
-		*	\tparam T		Type of operands.
-		*
-		*	\param[in] _lhs		Left hand side operand to compare.
-		*	\param[in] _rhs		Right hand side operand to compare.
-		*	\param[in] _size	Size of tabs to compare compare.
-		*	\param[in] _epsilon	Epsilon value for threshold compare.
-		*
-		*	\return	True on equality, otherwise false.
-		*/
-		template <typename T>
-		bool Equals(const T* _lhs, const T* _rhs, unsigned int _size, const T& _epsilon)
+		namespace Intl
 		{
-			for (unsigned int i = 0; i < _size; ++i)
+			void Update(bool _pred)
 			{
-				if (!Equals(_lhs[i], _rhs[i], _epsilon))
-					return false;
+				globalCount.Update(_pred);
+
+				StatsRecord(_pred);
+				ProgressRecord();
+
+				Group::Update(_pred);
 			}
 
-			return true;
-		}
+			void Update(bool _pred, const TestSite& _site)
+			{
+				Update(_pred);
 
-//}
+				if (ResultBatchCB)
+					RecordResult(_pred, _site);
+			}
 
+			void RecordResult(bool _pred, const TestSite& _site)
+			{
+				thread_local const std::shared_ptr<ResultBuffer> buffer = []()
+				{
+					std::shared_ptr<ResultBuffer> res = std::make_shared<ResultBuffer>();
+					res->records.reserve(resultBatchSize);
 
-//{ Random
+					std::lock_guard<std::mutex> lock(resultBuffersMutex);
+					resultBuffers.push_back(res);
 
-		/**
-		*	\brief Rand between [min, max[ (max excluded).
-		*
-		*	\tparam T			Type of the rand.
-		*	\param[in] _min		Min bound for rand (included).
-		*	\param[in] _max		Max bound for rand (excluded).
-		*
-		*	\return Random T between [min, max[ (max excluded).
-		*/
-		template <typename T>
-		T Rand(T _min = T(0), T _max = T(1))
-		{
-			return _min + static_cast<T>(rand()) / static_cast<T>(RAND_MAX / (_max - _min));
-		}
+					return res;
+				}();
 
-		/**
-		*	\brief Rand specialization for bool.
-		*
-		*	\param[in] _min		Min bound (false) (included).
-		*	\param[in] _max		Max bound (true) (included).
-		*
-		*	\return Random bool.
-		*/
-		template<>
-		inline bool Rand(bool _min, bool _max) { (void)_min; (void)_max; return Rand<int>(0, 2) == 1; }
+				const uint64_t ticks = Timer::Stop();
 
-//}
+				ResultRecord record;
+				record.site = &_site;
+				record.thread = ThreadIndex();
+				const uint64_t origin = OriginTicks(ticks);
+				record.timestamp = ticks > origin ? static_cast<uint64_t>(Timer::ToNs(static_cast<double>(ticks - origin))) : 0u;
+				record.pred = _pred;
 
+				std::vector<ResultRecord> batch;
 
-//{ Compute
+				{
+					std::lock_guard<std::mutex> lock(buffer->mutex);
 
-		/// \cond Internal
+					buffer->records.push_back(record);
 
-		namespace Intl
-		{
-			/// Total number of test run.
-			inline Counter globalCount;
+					if (buffer->records.size() < resultBatchSize || !ResultBatchCB)
+						return;
 
-			/// Update UTH module from predicate.
-			inline void Update(bool _pred);
+					batch.swap(buffer->records);
+					buffer->records.reserve(resultBatchSize);
+				}
+
+				// Called unlocked: the callback may run tests.
+				ResultBatchCB(batch.data(), batch.size());
+			}
+
+			void FlushResults()
+			{
+				std::vector<std::vector<ResultRecord>> batches;
+
+				{
+					std::lock_guard<std::mutex> lock(resultBuffersMutex);
+
+					for (auto it = resultBuffers.begin(); it != resultBuffers.end(); ++it)
+					{
+						std::lock_guard<std::mutex> bufferLock((*it)->mutex);
+
+						if ((*it)->records.empty())
+							continue;
+
+						batches.emplace_back();
+						batches.back().swap((*it)->records);
+						(*it)->records.reserve(resultBatchSize);
+					}
+				}
+
+				if (!ResultBatchCB)
+					return;
+
+				// Called unlocked: the callback may run tests.
+				for (auto it = batches.begin(); it != batches.end(); ++it)
+					ResultBatchCB(it->data(), it->size());
+			}
 			
+		// noinline definition of an inline declaration is intended (fixed frame count).
+		#if defined(__GNUC__) && !defined(__clang__)
+			#pragma GCC diagnostic push
+			#pragma GCC diagnostic ignored "-Wattributes"
+		#endif
 
-			/// Compute title from function declaration and line num.
-			inline void ComputeTitle(const Title& _infos);
+			SA_UTH_NOINLINE void ComputeTitle(const Title& _infos)
+			{
+				// Stack and trace refer to the failure: captured now (even if deferred).
+				if (!_infos.pred && !bSoftReport)
+				{
+					if (verbosity & Verbosity::FailureStack)
+						CaptureFailureStack(_infos);
 
+					if (bTrace)
+						TraceFailure(_infos);
+				}
+
+				if (ShouldDefer(_infos.pred))
+				{
+					RecordSoftFailure(SoftFailure{ nullptr, _infos.funcDecl, _infos.fileName, _infos.lineNum });
+					return;
+				}
+
+				OutputTitle(_infos);
+			}
+
+			SA_UTH_NOINLINE void ComputeTitle(const TestSite& _site, bool _pred)
+			{
+				const bool bFailureInfos = !_pred && !bSoftReport && ((verbosity & Verbosity::FailureStack) || bTrace);
+
+				// Title built on report.
+				if (!bFailureInfos && ShouldDefer(_pred))
+				{
+					RecordSoftFailure(SoftFailure{ &_site });
+					return;
+				}
+
+				const std::string funcDecl = _site.funcDecl;
+				const std::string fileName = _site.FileName();
+				const Title infos{ funcDecl, fileName, _site.lineNum, _pred };
+
+				if (bFailureInfos)
+				{
+					if (verbosity & Verbosity::FailureStack)
+						CaptureFailureStack(infos);
+
+					if (bTrace)
+						TraceFailure(infos);
+				}
+
+				if (ShouldDefer(_pred))
+				{
+					RecordSoftFailure(SoftFailure{ &_site });
+					return;
+				}
+
+				OutputTitle(infos);
+			}
+
+		#if defined(__GNUC__) && !defined(__clang__)
+			#pragma GCC diagnostic pop
+		#endif
+
+			void OutputTitle(const Title& _infos)
+			{
+				if (ShouldLog(_infos.pred ? Verbosity::Success : Verbosity::None))
+					_infos.Log();
+
+				if (TitleCB)
+					TitleCB(_infos);
+
+				Notify(Event::Title, [&_infos](Listener& _listener) { _listener.OnTitle(_infos); });
+			}
+
+			void TraceFailure(const Title& _infos)
+			{
+				Trace::instance.Instant(_infos.funcDecl, "assert",
+					"{\"file\":\"" + JsonEscape(_infos.fileName) + "\",\"line\":" + std::to_string(_infos.lineNum) + '}');
+			}
+
+
+			bool ShouldComputeParams(bool _pred)
+			{
+				// Should output params on success / on failure.
+				const unsigned int flag = _pred ? Verbosity::ParamsSuccess : Verbosity::ParamsFailure;
+
+				if (!(verbosity & flag))
+					return false;
+
+				return ShouldLog(flag) || ParamsCB || HasListener(Event::Params) || ParamViewsCB || HasListener(Event::ParamViews);
+			}
 
-			/// Compute params.
 			template <typename... Args>
-			void ComputeParam(bool _pred, std::string _paramNames, const Args&... _args);
+			void ComputeParam(bool _pred, std::string _paramNames, const Args&... _args)
+			{
+				// No need to compute params.
+				if (!ShouldComputeParams(_pred))
+					return;
 
-			/// \brief Generate Params from params' names and values.
-			template <typename FirstT, typename... Args>
-			void GenerateParamStr(std::vector<Param>& _result, std::string _paramNames, const FirstT& _first, const Args&... _args);
+				std::vector<ParamView> views;
 
+				// Snapshot values: output on group end.
+				if (ShouldDefer(_pred))
+				{
+					GenerateParamViews(views, true, _paramNames, _args...);
+					RecordSoftParams(std::move(views));
 
-			/// Compute the result using _pred predicate.
-			inline void ComputeResult(bool _pred);
+					return;
+				}
 
-			/// Wether to continue computing test with predicate _pred.
-			inline bool ShouldComputeTest(bool _pred);
+				GenerateParamViews(views, false, _paramNames, _args...);
+
+				ComputeParamViews(_pred, views);
+			}
 
-			/// \brief Helper function for size of VA_ARGS (handle empty args).
 			template <typename... Args>
-			unsigned int SizeOfArgs(const Args&...);
-		}
+			void ComputeParam(const TestSite& _site, bool _pred, const Args&... _args)
+			{
+				if (!ShouldDefer(_pred))
+				{
+					ComputeParam(_pred, _site.paramNames, _args...);
+					return;
+				}
 
-		/// \endcond
+				if (!ShouldComputeParams(_pred))
+					return;
 
-//}
+				// Snapshot values only: named on report.
+				std::vector<ParamView> views;
+				views.reserve(sizeof...(Args));
 
+				(views.push_back(ParamView::Snapshot(std::string(), _args)), ...);
 
-//}
+				RecordSoftParams(std::move(views));
+			}
 
+			void NameParams(std::vector<ParamView>& _views, const char* _paramNames)
+			{
+				std::string_view names = _paramNames;
 
-//{ Cpp
+				for (auto it = _views.begin(); it != _views.end(); ++it)
+				{
+					const size_t index = names.find(',');
 
-		/// \cond
+					it->name = names.substr(0u, index);
+					names = index == std::string_view::npos ? std::string_view() : names.substr((std::min)(index + 2u, names.size()));
+				}
+			}
 
-//{ Init / Exit
+			void ComputeParamViews(bool _pred, const std::vector<ParamView>& _views)
+			{
+				const unsigned int flag = _pred ? Verbosity::ParamsSuccess : Verbosity::ParamsFailure;
 
-		namespace Intl
-		{
-			void Init()
+				const bool bLog = ShouldLog(flag);
+
+				if (ParamViewsCB)
+					ParamViewsCB(_views);
+
+				Notify(Event::ParamViews, [&_views](Listener& _listener) { _listener.OnParamViews(_views); });
+
+				// Stringify only for log and string params callbacks.
+				if (!bLog && !ParamsCB && !HasListener(Event::Params))
+					return;
+
+				std::vector<Param> params;
+				params.reserve(_views.size());
+
+				for (auto it = _views.begin(); it != _views.end(); ++it)
+					params.push_back(Param{ it->name, it->ToString() });
+
+				if (bLog)
+				{
+					LogFlagScope flagScope(flag);
+					Param::Log(params);
+				}
+
+				if (ParamsCB)
+					ParamsCB(params);
+
+				Notify(Event::Params, [&params](Listener& _listener) { _listener.OnParams(params); });
+			}
+
+			template <typename FirstT, typename... Args>
+			void GenerateParamViews(std::vector<ParamView>& _result, bool _bSnapshot, std::string _paramNames, const FirstT& _first, const Args&... _args)
 			{
-				using namespace Intl;
+				size_t index = _paramNames.find_first_of(',');
 
-				SetConsoleColor(CslColor::Init);
+				if (_bSnapshot)
+					_result.push_back(ParamView::Snapshot(_paramNames.substr(0u, index), _first));
+				else
+					_result.push_back(ParamView::Make(_paramNames.substr(0u, index), _first));
 
-				// Init rand.
-				time_t currTime = time(NULL);
-				srand(static_cast<unsigned int>(currTime));
-				SA_UTH_LOG("[SA-UTH] Init Rand seed: " << currTime);
+				if constexpr (sizeof...(_args) != 0)
+					GenerateParamViews(_result, _bSnapshot, _paramNames.substr(index + 2), _args...);
+			}
 
-				SetConsoleColor(CslColor::None);
+
+			bool ShouldDefer(bool _pred)
+			{
+			#if SA_UTH_EXIT_ON_FAILURE
+				(void)_pred;
+				return false;
+			#else
+				return !_pred && bSoftAssert && !bSoftReport && Group::IsRunning();
+			#endif
 			}
 
-			int Exit()
+			void RecordSoftFailure(SoftFailure&& _failure)
 			{
-				using namespace Intl;
+				std::lock_guard<std::mutex> lock(softFailuresMutex);
 
-				// Reset to default.
-				bCslLog = SA_UTH_DFLT_CSL_LOG;
-				bFileLog = SA_UTH_DFLT_FILE_LOG;
+				softFailureCurrent = softFailures.size();
+				softFailures.push_back(std::move(_failure));
+			}
 
-				SetConsoleColor(CslColor::Exit);
-				__SA_UTH_LOG_IN("[SA-UTH] Run: ");
+			void RecordSoftParams(std::vector<ParamView>&& _views)
+			{
+				std::lock_guard<std::mutex> lock(softFailuresMutex);
 
+				if (softFailureCurrent < softFailures.size())
+					softFailures[softFailureCurrent].params = std::move(_views);
+			}
 
-				Intl::globalCount.Log();
+			void ReportSoftFailures(size_t _index)
+			{
+				std::vector<SoftFailure> failures;
 
-				// Output Group counter.
-				if ((verbosity & Verbosity::GroupCount) && !Group::globalCount.IsEmpty())
 				{
-					SetConsoleColor(CslColor::Exit);
-					__SA_UTH_LOG_IN(" in ");
+					std::lock_guard<std::mutex> lock(softFailuresMutex);
 
-					Group::globalCount.Log();
+					if (_index >= softFailures.size())
+						return;
 
-					SetConsoleColor(CslColor::GroupEnd);
-					__SA_UTH_LOG_IN(" groups");
+					failures.assign(std::make_move_iterator(softFailures.begin() + _index), std::make_move_iterator(softFailures.end()));
+					softFailures.erase(softFailures.begin() + _index, softFailures.end());
 				}
 
+				const auto fileName = [](const SoftFailure& _failure)
+				{
+					return _failure.site ? std::string_view(_failure.site->FileName()) : std::string_view(_failure.fileName);
+				};
 
-				// Output exit.
-				SetConsoleColor(CslColor::Exit);
-				__SA_UTH_LOG_IN(" and exit with code: ");
+				const auto lineNum = [](const SoftFailure& _failure)
+				{
+					return _failure.site ? _failure.site->lineNum : _failure.lineNum;
+				};
 
-				if (exit == EXIT_SUCCESS)
+				std::stable_sort(failures.begin(), failures.end(), [&fileName, &lineNum](const SoftFailure& _lhs, const SoftFailure& _rhs)
 				{
-					SetConsoleColor(CslColor::Success);
-					__SA_UTH_LOG_IN("EXIT_SUCCESS (" << EXIT_SUCCESS << ')');
-				}
-				else
+					const std::string_view lhsFile = fileName(_lhs);
+					const std::string_view rhsFile = fileName(_rhs);
+
+					return lhsFile != rhsFile ? lhsFile < rhsFile : lineNum(_lhs) < lineNum(_rhs);
+				});
+
+				if (ShouldLog(Verbosity::None))
 				{
 					SetConsoleColor(CslColor::Failure);
-					__SA_UTH_LOG_IN("EXIT_FAILURE (" << EXIT_FAILURE << ')');
+					SA_UTH_LOG("[SA-UTH] Soft failures: " << failures.size() << " (sorted by location)");
+
+					SetConsoleColor(CslColor::None);
 				}
 
-				__SA_UTH_LOG_ENDL();
-				SetConsoleColor(CslColor::None);
+				bSoftReport = true;
 
-			#if SA_UTH_EXIT_PAUSE && !defined(SA_CI)
-				SA_UTH_LOG("[SA-UTH] Press Enter to continue...");
-				std::cin.get();
-			#endif
+				for (auto it = failures.begin(); it != failures.end(); ++it)
+				{
+					if (it->site)
+					{
+						ComputeTitle(*it->site, false);
+						NameParams(it->params, it->site->paramNames);
+					}
+					else
+						ComputeTitle(Title{ it->funcDecl, it->fileName, it->lineNum, false });
+
+					if (!it->params.empty())
+						ComputeParamViews(false, it->params);
+
+					ComputeResult(false);
+				}
 
-				return exit;
+				bSoftReport = false;
 			}
-		}
-
-//}
-
 
-//{ Logger
 
-		namespace Intl
-		{
-			Logger::Logger()
+			void ComputeResult(bool _pred)
 			{
-				time_t currTime = time(NULL);
+				// Computed on group end.
+				if (ShouldDefer(_pred))
+					return;
 
-				// Open Log file.
+				if (!_pred)
 				{
-					std::filesystem::create_directories("Logs");
+					std::lock_guard<std::mutex> lock(failureMutex);
+					Sa::UTH::exit = EXIT_FAILURE;
+				}
 
-					struct tm timeinfo;
+				// Output logs leading to the failure.
+				if (!_pred && bFlightRecorder)
+					FlightRecorder::Dump();
 
-				# if _WIN32
-					localtime_s(&timeinfo, &currTime);
-				#else
-					localtime_r(&currTime, &timeinfo);
-				#endif
+				if (ResultCB)
+					ResultCB(_pred);
 
-					/**
-					*	log_UTH-<month>.<day>.<year>-<hour>h<minute>m<second>s.txt
-					*	Ex: 2/27/2021 at 12:07:43
-					*	log_UTH-2.27.2021-12h07m43s.txt
-					*/
-					logFileName = std::string("Logs/log_UTH-") +
-						std::to_string(timeinfo.tm_mon + 1) + '.' +
-						std::to_string(timeinfo.tm_mday) + '.' +
-						std::to_string(timeinfo.tm_year + 1900) + '-' +
-						std::to_string(timeinfo.tm_hour) + 'h' +
-						std::to_string(timeinfo.tm_min) + 'm' +
-						std::to_string(timeinfo.tm_sec) + 's' +
-						".txt";
+				Notify(Event::Result, [_pred](Listener& _listener) { _listener.OnResult(_pred); });
 
-					logFile.open(logFileName, std::ios::out | std::ios::app);
+#if SA_UTH_EXIT_ON_FAILURE
+				if (!_pred)
+				{
+					LogFailureStacks();
+					::exit(EXIT_FAILURE);
 				}
+#endif
 			}
 
-			Logger::~Logger()
-			{
-				// Close log file.
-				logFile.close();
-			}
-
+		// noinline definition of an inline declaration is intended (fixed frame count).
+		#if defined(__GNUC__) && !defined(__clang__)
+			#pragma GCC diagnostic push
+			#pragma GCC diagnostic ignored "-Wattributes"
+		#endif
 
-#if _WIN32
-			void SetConsoleColor(CslColor _result)
+			SA_UTH_NOINLINE void CaptureFailureStack(const Title& _infos)
 			{
-				static HANDLE hConsole = GetStdHandle(STD_OUTPUT_HANDLE);
-
-				switch (_result)
+			#if SA_UTH_BACKTRACE
 				{
-					case CslColor::None:
-						SetConsoleTextAttribute(hConsole, 15);
-						break;
-					case CslColor::Title:
-						SetConsoleTextAttribute(hConsole, 14);
-						break;
-					case CslColor::Success:
-						SetConsoleTextAttribute(hConsole, 10);
-						break;
-					case CslColor::Failure:
-						SetConsoleTextAttribute(hConsole, 12);
-						break;
-					case CslColor::TestNum:
-						SetConsoleTextAttribute(hConsole, 6);
-						break;
-					case CslColor::GroupBegin:
-						SetConsoleTextAttribute(hConsole, 3);
-						break;
-					case CslColor::GroupEnd:
-						SetConsoleTextAttribute(hConsole, 3);
-						break;
-					case CslColor::Init:
-						SetConsoleTextAttribute(hConsole, 13);
-						break;
-					case CslColor::Exit:
-						SetConsoleTextAttribute(hConsole, 13);
-						break;
-					case CslColor::ParamWarning:
-						SetConsoleTextAttribute(hConsole, 6);
-						break;
-					default:
-						SA_UTH_LOG("CslColor not supported yet!");
-						break;
+					std::lock_guard<std::mutex> lock(failureRecordsMutex);
+
+					if (failureRecords.size() >= maxFailureRecords)
+					{
+						++failureRecordsDropped;
+						return;
+					}
 				}
+
+				// Skip CaptureFailureStack and ComputeTitle frames.
+				constexpr int skipped = 2;
+
+				void* frames[64];
+				const int depth = backtrace(frames, 64);
+
+				if (depth <= skipped)
+					return;
+
+				FailureRecord record{ _infos.funcDecl, _infos.fileName, _infos.lineNum };
+				record.stack.assign(frames + skipped, frames + depth);
+
+				std::lock_guard<std::mutex> lock(failureRecordsMutex);
+				failureRecords.push_back(std::move(record));
+			#else
+				// No call stack: nothing to output.
+				(void)_infos;
+			#endif
 			}
-#else
-			void SetConsoleColor(CslColor _result)
+
+		#if defined(__GNUC__) && !defined(__clang__)
+			#pragma GCC diagnostic pop
+		#endif
+
+			void LogFailureStacks()
 			{
-				switch (_result)
+				std::vector<FailureRecord> records;
+				size_t dropped = 0u;
+
 				{
-					case CslColor::None:
-						std::cout << "\033[0;0m";
-						break;
-					case CslColor::Title:
-						std::cout << "\033[0;33m";
-						break;
-					case CslColor::Success:
-						std::cout << "\033[0;32m";
-						break;
-					case CslColor::Failure:
-						std::cout << "\033[0;31m";
-						break;
-					case CslColor::TestNum:
-						std::cout << "\033[1;33m";
-						break;
-					case CslColor::GroupBegin:
-						std::cout << "\033[1;34m";
-						break;
-					case CslColor::GroupEnd:
-						std::cout << "\033[1;34m";
-						break;
-					case CslColor::Init:
-						std::cout << "\033[0;35m";
-						break;
-					case CslColor::Exit:
-						std::cout << "\033[0;35m";
-						break;
-					case CslColor::ParamWarning:
-						std::cout << "\033[1;33m";
-						break;
-					default:
-						SA_UTH_LOG("CslColor not supported yet!");
-						break;
+					std::lock_guard<std::mutex> lock(failureRecordsMutex);
+
+					records.swap(failureRecords);
+					std::swap(dropped, failureRecordsDropped);
 				}
-			}
-#endif
 
-			bool ShouldLog() noexcept
-			{
-				return bCslLog || bFileLog;
-			}
+				if (records.empty() || !ShouldLog(Verbosity::FailureStack))
+					return;
 
-			std::string IndentStr(std::string _str)
-			{
-				const std::string indentStr = std::string("\n") + Group::TabStr();
+				LogFlagScope flagScope(Verbosity::FailureStack);
 
-				size_t index = _str.find('\n');
+				// Symbolize each address once.
+				std::unordered_map<void*, std::string> symbols;
 
-				while (index != std::string::npos)
+				for (auto it = records.begin(); it != records.end(); ++it)
 				{
-					_str.replace(index, 1, indentStr);
+					SetConsoleColor(CslColor::Failure);
+					SA_UTH_LOG("[SA-UTH] Failure stack: " << it->funcDecl << " -- " << it->fileName << ':' << it->lineNum);
 
-					index = _str.find('\n', index + indentStr.size());
-				}
+					SetConsoleColor(CslColor::None);
 
-				return _str;
-			}
+					unsigned int frameNum = 0u;
 
-			/// Getter of file name.
-			const char* GetFileNameFromPath(const char* _filePath) noexcept
-			{
-				// Remove characters until last backslash.
-				const char* fileName = strrchr(_filePath, '\\');
+					for (auto addrIt = it->stack.begin(); addrIt != it->stack.end(); ++addrIt)
+					{
+						auto symIt = symbols.find(*addrIt);
 
-				if (!fileName) // No backslash found.
-					fileName = _filePath;
-				else
-					fileName += 1; // Remove last '\\' found.
+						// Return address points after the call instruction.
+						if (symIt == symbols.end())
+							symIt = symbols.emplace(*addrIt, SymbolName(static_cast<char*>(*addrIt) - 1)).first;
 
+						// Hide UTH internal frames.
+						if (symIt->second.compare(0u, 15u, "Sa::UTH::Intl::") == 0)
+							continue;
 
-				// Remove characters until last slash.
-				if (const char* filePathNoSlash = strrchr(fileName, '/'))
+						SA_UTH_LOG("\t#" << frameNum << ' ' << symIt->second);
+						++frameNum;
+					}
+				}
+
+				if (dropped)
 				{
-					// Remove last '/' found.
-					fileName = filePathNoSlash + 1;
+					SetConsoleColor(CslColor::ParamWarning);
+					SA_UTH_LOG("[SA-UTH] Failure stacks: " << dropped << " more not recorded (limit: " << maxFailureRecords << ')');
+					SetConsoleColor(CslColor::None);
 				}
+			}
 
-				return fileName;
+			inline bool ShouldComputeTest(bool _pred)
+			{
+				return !_pred || (verbosity & Verbosity::Success);
 			}
-		}
 
-//}
 
+			void ComputeBench(const Bench& _bench)
+			{
+				if (ShouldLog(Verbosity::BenchResult))
+					Bench::Log(_bench);
 
-//{ Counter
+				if (BenchCB)
+					BenchCB(_bench);
 
-		unsigned int Counter::Total() const
-		{
-			return success + failure;
-		}
+				Notify(Event::Bench, [&_bench](Listener& _listener) { _listener.OnBench(_bench); });
+			}
 
-		void Counter::Update(bool _pred)
-		{
-			if (_pred)
-				++success;
-			else
-				++failure;
-		}
+			void CheckComplexity(const Bench& _bench, const std::string& _fileName, unsigned int _lineNum)
+			{
+				(void)_bench;
+				(void)_fileName;
+				(void)_lineNum;
+			}
 
-		Counter& Counter::operator+=(const Counter& _rhs) noexcept
-		{
-			success += _rhs.success;
-			failure += _rhs.failure;
+			void CheckComplexity(const Bench& _bench, const std::string& _fileName, unsigned int _lineNum, Complexity _expected)
+			{
+				const bool bRes = _bench.complexity <= _expected;
+				Update(bRes);
 
-			return *this;
-		}
+				if (ShouldComputeTest(bRes))
+				{
+					const std::string titleStr = "Sa::UTH::Bench(" + _bench.name + ").complexity <= " + ToString(_expected);
 
-		void Counter::Log() const
-		{
-			using namespace Intl;
+					ComputeTitle(Title{ titleStr, _fileName, _lineNum, bRes });
+					ComputeParam(bRes, "complexity, expected", _bench.complexity, _expected);
+					ComputeResult(bRes);
+				}
+			}
 
-			SetConsoleColor(CslColor::TestNum);
-			__SA_UTH_LOG_IN(Total());
+			void CheckSpeedup(const BenchCompare& _compare, const std::string& _fileName, unsigned int _lineNum)
+			{
+				const bool bRes = _compare.IsFaster();
+				Update(bRes);
 
-			if (failure)
+				if (ShouldComputeTest(bRes))
+				{
+					std::ostringstream titleStr;
+					titleStr << "Sa::UTH::BenchCompare(" << _compare.name << "): candidate >= " <<
+						_compare.minSpeedup * 100.0 << "% faster (p < " << _compare.alpha << ')';
+
+					const std::string title = titleStr.str();
+
+					ComputeTitle(Title{ title, _fileName, _lineNum, bRes });
+					ComputeParam(bRes, "speedup, minSpeedup, pValue", _compare.speedup, _compare.minSpeedup, _compare.pValue);
+					ComputeResult(bRes);
+				}
+			}
+
+			void CheckScaling(const BenchScaling& _scaling, const std::string& _fileName, unsigned int _lineNum)
 			{
-				__SA_UTH_LOG_IN(" (");
+				// No speedup required.
+				if (_scaling.minSpeedup <= 0.0)
+					return;
 
-				SetConsoleColor(CslColor::Success);
-				__SA_UTH_LOG_IN(success);
+				const bool bRes = _scaling.IsScaling();
+				Update(bRes);
 
-				SetConsoleColor(CslColor::TestNum);
-				__SA_UTH_LOG_IN('/');
+				if (ShouldComputeTest(bRes))
+				{
+					std::ostringstream titleStr;
+					titleStr << "Sa::UTH::BenchScaling(" << _scaling.name << "): speedup at " <<
+						(_scaling.samples.empty() ? 0u : _scaling.samples.back().threads) << " threads >= " << _scaling.minSpeedup;
 
-				SetConsoleColor(CslColor::Failure);
-				__SA_UTH_LOG_IN(failure);
+					const std::string title = titleStr.str();
+					const double speedup = _scaling.samples.empty() ? 0.0 : _scaling.samples.back().speedup;
 
-				SetConsoleColor(CslColor::TestNum);
-				__SA_UTH_LOG_IN(')');
+					ComputeTitle(Title{ title, _fileName, _lineNum, bRes });
+					ComputeParam(bRes, "speedup, minSpeedup", speedup, _scaling.minSpeedup);
+					ComputeResult(bRes);
+				}
 			}
-		}
 
-		bool Counter::IsEmpty() const
-		{
-			return success != 0 && failure != 0;
-		}
+			void CheckPercentiles(const Latency& _latency, const std::string& _fileName, unsigned int _lineNum)
+			{
+				(void)_latency;
+				(void)_fileName;
+				(void)_lineNum;
+			}
 
-//}
+			template <typename... Args>
+			void CheckPercentiles(const Latency& _latency, const std::string& _fileName, unsigned int _lineNum,
+				const PercentileBound& _bound, const Args&... _bounds)
+			{
+				const uint64_t value = _latency.histogram.Percentile(_bound.percentile);
+				const bool bRes = value < _bound.bound;
+				Update(bRes);
 
+				if (ShouldComputeTest(bRes))
+				{
+					const std::string percentileStr = FormatPercentile(_bound.percentile);
+					const std::string boundStr = FormatDuration(static_cast<double>(_bound.bound));
+					const std::string title = "Sa::UTH::Latency(" + _latency.name + ")." + percentileStr + " < " + boundStr;
 
-//{ Title
+					ComputeTitle(Title{ title, _fileName, _lineNum, bRes });
+					ComputeParam(bRes, percentileStr + ", bound", FormatDuration(static_cast<double>(value)), boundStr);
+					ComputeResult(bRes);
+				}
 
-		void Title::Log() const
-		{
-			using namespace Intl;
+				CheckPercentiles(_latency, _fileName, _lineNum, _bounds...);
+			}
 
-			SetConsoleColor(CslColor::Title);
+			void ComputeLimitFailure(const Group& _group, const GroupLimits& _limits, double _cpuTime, size_t _addressSpace, size_t _resident, int _status,
+				const std::string& _fileName, unsigned int _lineNum)
+			{
+				Update(false);
 
-			Group::LogTabs();
-			__SA_UTH_LOG_IN("[SA-UTH] ");
+				std::string title = "Sa::UTH::Group(" + _group.name + "): ";
+				std::string limitStr;
+				std::string usageStr;
 
-			// Result.
-			if (pred)
-			{
-				SetConsoleColor(CslColor::Success);
-				__SA_UTH_LOG_IN("Success ");
+				switch (_group.limitFailure)
+				{
+					case LimitFailure::Memory:
+						title += "memory limit exceeded";
+						limitStr = std::to_string(_limits.memory) + " bytes (address space)";
+						usageStr = _addressSpace ? std::to_string(_addressSpace) + " bytes (peak address space)" :
+							std::to_string(_resident) + " bytes (peak resident)";
+						break;
+					case LimitFailure::CpuTime:
+						title += "CPU time limit exceeded";
+						limitStr = std::to_string(_limits.cpuTime) + " s";
+						usageStr = FormatDuration(_cpuTime * 1e9);
+						break;
+					default:
+					{
+						title += "crashed";
+						limitStr = "memory: " + std::to_string(_limits.memory) + " bytes, CPU time: " + std::to_string(_limits.cpuTime) + " s";
+
+					#if _WIN32
+						(void)_status;
+						usageStr = "unknown";
+					#else
+						usageStr = WIFSIGNALED(_status) ? "signal " + std::to_string(WTERMSIG(_status)) :
+							"exit code " + std::to_string(WEXITSTATUS(_status));
+					#endif
+						break;
+					}
+				}
+
+				ComputeTitle(Title{ title, _fileName, _lineNum, false });
+				ComputeParam(false, "limit, usage", limitStr, usageStr);
+				ComputeResult(false);
 			}
-			else
+
+			size_t PeakAddressSpace() noexcept
 			{
-				SetConsoleColor(CslColor::Failure);
-				__SA_UTH_LOG_IN("Failure ");
-			}
+			#if __linux__
+				// No allocation: may be called right after a std::bad_alloc.
+				FILE* const file = fopen("/proc/self/status", "r");
 
-			SetConsoleColor(CslColor::Title);
+				if (!file)
+					return 0u;
 
-			__SA_UTH_LOG_IN(funcDecl << " -- " << fileName << ":" << lineNum << std::endl);
+				char line[128];
+				unsigned long long kiB = 0u;
 
-			SetConsoleColor(CslColor::None);
-		}
+				while (fgets(line, sizeof(line), file))
+				{
+					if (sscanf(line, "VmPeak: %llu kB", &kiB) == 1)
+						break;
+				}
 
-//}
+				fclose(file);
 
+				return static_cast<size_t>(kiB) * 1024u;
+			#else
+				return 0u;
+			#endif
+			}
 
-//{ Group
+			std::string FormatPercentile(double _percentile)
+			{
+				std::ostringstream res;
+				res << 'p' << std::setprecision(6) << _percentile;
 
-		void Group::Update(bool _pred)
-		{
-			// Update top group.
-			if (!Group::sGroups.empty())
+				return res.str();
+			}
+
+			unsigned int HighestBit(uint64_t _value) noexcept
 			{
-				Group& gp = Group::sGroups.top();
+			#if defined(__GNUC__) || defined(__clang__)
+				return 63u - static_cast<unsigned int>(__builtin_clzll(_value));
+			#elif _WIN64
+				unsigned long index = 0u;
+				_BitScanReverse64(&index, _value);
 
+				return static_cast<unsigned int>(index);
+			#else
+				unsigned int index = 0u;
 
-				gp.count.Update(_pred);
+				while (_value >>= 1u)
+					++index;
 
-				if (!_pred)
-					gp.localExit = EXIT_FAILURE;
+				return index;
+			#endif
 			}
-		}
-
-		void Group::Spread(Group& _parent)
-		{
-			if (localExit == EXIT_FAILURE)
-				_parent.localExit = EXIT_FAILURE;
 
-			_parent.count += count;
-		}
+			double MannWhitneyU(const std::vector<double>& _lhs, const std::vector<double>& _rhs)
+			{
+				if (_lhs.empty() || _rhs.empty())
+					return 1.0;
 
-		void Group::Begin(const std::string& _name)
-		{
-			// Log before push for log indentation.
-			if ((verbosity & Verbosity::GroupStart) && Intl::ShouldLog())
-				BeginLog(_name);
+				// U: number of pairs where lhs < rhs (ties count half).
+				double u = 0.0;
 
-			sGroups.push(Group{ _name });
+				for (auto lIt = _lhs.begin(); lIt != _lhs.end(); ++lIt)
+				{
+					for (auto rIt = _rhs.begin(); rIt != _rhs.end(); ++rIt)
+					{
+						if (*lIt < *rIt)
+							u += 1.0;
+						else if (*lIt == *rIt)
+							u += 0.5;
+					}
+				}
 
-			if (GroupBeginCB)
-				GroupBeginCB(_name);
-		}
+				const double n1 = static_cast<double>(_lhs.size());
+				const double n2 = static_cast<double>(_rhs.size());
 
-		Group Group::End()
-		{
-			Group group = sGroups.top();
-			sGroups.pop();
+				const double mean = n1 * n2 / 2.0;
+				const double sigma = std::sqrt(n1 * n2 * (n1 + n2 + 1.0) / 12.0);
 
-			// Spread values to parent.
-			if (!sGroups.empty())
-				group.Spread(sGroups.top());
+				// Normal approximation with continuity correction.
+				const double z = (u - mean - 0.5) / sigma;
 
-			if ((verbosity & Verbosity::GroupExit) && Intl::ShouldLog())
-				EndLog(group);
+				return 0.5 * std::erfc(z / std::sqrt(2.0));
+			}
 
-			if (GroupEndCB)
-				GroupEndCB(group);
+			template <typename FuncT>
+			void RunBenchBody(FuncT& _body, BenchState& _state)
+			{
+				if constexpr (std::is_invocable<FuncT&, BenchState&>::value)
+				{
+					if constexpr (std::is_void<std::invoke_result_t<FuncT&, BenchState&>>::value)
+						_body(_state);
+					else
+						DoNotOptimize(_body(_state));
+				}
+				else if constexpr (std::is_invocable<FuncT&, size_t>::value)
+				{
+					if constexpr (std::is_void<std::invoke_result_t<FuncT&, size_t>>::value)
+						_body(_state.n);
+					else
+						DoNotOptimize(_body(_state.n));
+				}
+				else
+				{
+					if constexpr (std::is_void<std::invoke_result_t<FuncT&>>::value)
+						_body();
+					else
+						DoNotOptimize(_body());
+				}
+			}
 
-			globalCount.Update(group.localExit == EXIT_SUCCESS);
+			template <typename FuncT>
+			double MeasureBenchBody(FuncT& _body, BenchState& _state, unsigned int _iterations, const BenchEnv& _env)
+			{
+				// Warm cache: time every call at once.
+				if (!_env.bColdCache)
+				{
+					const uint64_t start = Timer::Start();
 
-			return group;
-		}
+					for (unsigned int i = 0u; i < _iterations; ++i)
+						RunBenchBody(_body, _state);
 
+					ClobberMemory();
 
-		void Group::BeginLog(const std::string& _name)
-		{
-			using namespace Intl;
+					return Timer::Elapsed(start, Timer::Stop());
+				}
 
-			SetConsoleColor(CslColor::GroupBegin);
-			SA_UTH_LOG("[SA-UTH] Group:\t" << _name);
-			SetConsoleColor(CslColor::None);
-		}
+				// Cold cache: flush before each call, out of the timed section.
+				double elapsed = 0.0;
 
-		void Group::EndLog(const UTH::Group& _group)
-		{
-			using namespace Intl;
+				for (unsigned int i = 0u; i < _iterations; ++i)
+				{
+					FlushCache(_env.cacheSize);
 
-			LogTabs();
-			SetConsoleColor(CslColor::GroupEnd);
+					const uint64_t start = Timer::Start();
 
-			__SA_UTH_LOG_IN("[SA-UTH] Group:\t" << _group.name << " run: ");
+					RunBenchBody(_body, _state);
+					ClobberMemory();
 
-			_group.count.Log();
+					elapsed += Timer::Elapsed(start, Timer::Stop());
+				}
 
-			SetConsoleColor(CslColor::GroupEnd);
-			__SA_UTH_LOG_IN(" and exit with code: ");
+				return elapsed;
+			}
 
-			if (_group.localExit == EXIT_SUCCESS)
+			template <typename FuncT>
+			unsigned int CalibrateBenchBody(FuncT& _body, BenchState& _state, const BenchEnv& _env, double _runTime, double& _ns)
 			{
-				SetConsoleColor(CslColor::Success);
-				__SA_UTH_LOG_IN("EXIT_SUCCESS (" << EXIT_SUCCESS << ')');
+				using Clock = std::chrono::steady_clock;
+
+				const Clock::time_point wallStart = Clock::now();
+
+				// Double iterations until a run lasts _runTime.
+				for (unsigned int iterations = 1u; ; iterations *= 2u)
+				{
+					const double elapsed = MeasureBenchBody(_body, _state, iterations, _env);
+					const double wallElapsed = std::chrono::duration<double>(Clock::now() - wallStart).count();
+
+					if (elapsed >= _runTime * 1e9 || wallElapsed >= benchSettings.maxTime || iterations >= (1u << 30))
+					{
+						_ns = elapsed / iterations;
+						return iterations;
+					}
+				}
 			}
-			else
+
+			template <typename FuncT>
+			BenchSample MeasureBenchSize(FuncT& _body, BenchState& _state, const BenchEnv& _env)
 			{
-				SetConsoleColor(CslColor::Failure);
-				__SA_UTH_LOG_IN("EXIT_FAILURE (" << EXIT_FAILURE << ')');
-			}
+				using Clock = std::chrono::steady_clock;
 
-			__SA_UTH_LOG_ENDL();
-			SetConsoleColor(CslColor::None);
-		}
+				const Clock::time_point wallStart = Clock::now();
+				const double runTime = benchSettings.bAdaptive ? benchSettings.runTime : benchSettings.minTime;
 
+				BenchSample sample;
+				sample.n = _state.n;
+				sample.iterations = CalibrateBenchBody(_body, _state, _env, runTime, sample.ns);
 
-		std::string Group::TabStr() noexcept
-		{
-			return std::string(sGroups.size(), '\t');
-		}
+				if (!benchSettings.bAdaptive)
+					return sample;
 
-		void Group::LogTabs() noexcept
-		{
-			if (sGroups.size())
-				__SA_UTH_LOG_IN(TabStr());
-		}
 
-//}
+				// Adaptive: sample runs until the median converges.
+				std::vector<double> runs{ sample.ns };
 
+				while (runs.size() < benchSettings.maxRuns)
+				{
+					const double ns = MeasureBenchBody(_body, _state, sample.iterations, _env) / sample.iterations;
+					runs.insert(std::lower_bound(runs.begin(), runs.end(), ns), ns);
 
-//{ Param
+					const double wallElapsed = std::chrono::duration<double>(Clock::now() - wallStart).count();
 
-		void Param::Log(const std::vector<Param>& _params)
-		{
-			using namespace Intl;
+					if (runs.size() >= benchSettings.minRuns)
+					{
+						sample.ci = MedianCI(runs, sample.ns);
 
-			for (auto it = _params.begin(); it != _params.end(); ++it)
+						if (sample.ci <= benchSettings.targetCI)
+							break;
+					}
+
+					if (wallElapsed >= benchSettings.maxTime)
+						break;
+				}
+
+				sample.ci = MedianCI(runs, sample.ns);
+				sample.runs = static_cast<unsigned int>(runs.size());
+
+				return sample;
+			}
+
+			double MedianCI(const std::vector<double>& _sorted, double& _median)
 			{
-				if (verbosity & Verbosity::ParamsName)
-					SA_UTH_LOG(it->name << ':');
+				const size_t size = _sorted.size();
 
-				// ToString not implemented.
-				if (it->value.empty())
+				if (size == 0u)
 				{
-					__SA_UTH_LOG_IN("-No debug string-\t");
-					SetConsoleColor(CslColor::ParamWarning);
-					__SA_UTH_LOG_IN("Implement ToString() in class or UTH::ToString template specialization.");
-					SetConsoleColor(CslColor::None);
+					_median = 0.0;
+					return 0.0;
 				}
-				else
-					SA_UTH_LOG(IndentStr(it->value));
-			}
-		}
 
-//}
+				_median = size % 2u ? _sorted[size / 2u] : (_sorted[size / 2u - 1u] + _sorted[size / 2u]) / 2.0;
 
+				// Ranks of the 95% confidence interval bounds: n/2 -/+ 1.96 * sqrt(n) / 2.
+				const double halfWidth = 1.96 * std::sqrt(static_cast<double>(size)) / 2.0;
 
-//{ Compute
+				const double lowRank = std::floor(size / 2.0 - halfWidth);
+				const double highRank = std::ceil(size / 2.0 + halfWidth);
 
-		namespace Intl
-		{
-			void Update(bool _pred)
-			{
-				globalCount.Update(_pred);
+				const size_t low = lowRank < 0.0 ? 0u : static_cast<size_t>(lowRank);
+				const size_t high = highRank >= size ? size - 1u : static_cast<size_t>(highRank);
 
-				Group::Update(_pred);
+				if (_median <= 0.0)
+					return 0.0;
+
+				return (_sorted[high] - _sorted[low]) / 2.0 / _median;
 			}
-			
-			void ComputeTitle(const Title& _infos)
+
+			void FlushCache(size_t _size)
 			{
-				if(ShouldLog())
-					_infos.Log();
+				// Per thread: scaling workers flush concurrently.
+				thread_local std::vector<char> buffer;
 
-				if (TitleCB)
-					TitleCB(_infos);
+				if (buffer.size() < _size)
+					buffer.resize(_size);
+
+				// Write then read one byte per cache line.
+				constexpr size_t lineSize = 64u;
+				char sum = 0;
+
+				for (size_t i = 0u; i < _size; i += lineSize)
+					++buffer[i];
+
+				for (size_t i = 0u; i < _size; i += lineSize)
+					sum += buffer[i];
+
+				DoNotOptimize(sum);
+				ClobberMemory();
 			}
 
 
-			template <typename... Args>
-			void ComputeParam(bool _pred, std::string _paramNames, const Args&... _args)
+			BenchEnvScope::BenchEnvScope(const BenchEnv& _requested) : applied{ _requested }
 			{
-				// No need to compute params.
-				if (!ShouldLog() && !ParamsCB)
-					return;
+				// CPU pinning.
+				if (applied.cpu >= 0)
+				{
+				#if _WIN32
+					if (applied.cpu < static_cast<int>(sizeof(DWORD_PTR) * 8u))
+						prevAffinity = SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << applied.cpu);
+
+					if (!prevAffinity)
+						applied.cpu = -1;
+				#elif __linux__
+					if (applied.cpu < CPU_SETSIZE)
+					{
+						cpu_set_t set;
+						CPU_ZERO(&set);
+						CPU_SET(applied.cpu, &set);
+
+						if (pthread_getaffinity_np(pthread_self(), sizeof(prevAffinity), &prevAffinity) != 0 ||
+							pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0)
+							applied.cpu = -1;
+					}
+					else
+						applied.cpu = -1;
+				#else
+					// Not supported on this platform.
+					applied.cpu = -1;
+				#endif
+				}
 
-				if ((_pred && (verbosity & ParamsSuccess)) ||		// Should output params on success.
-					(!_pred && (verbosity & ParamsFailure)))		// Should output params on failure.
+				// Floating-point modes.
+				if (applied.bFlushDenormals)
 				{
-					std::vector<Param> params;
-					GenerateParamStr(params, _paramNames, _args...);
+				#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
+					prevFPMode = _mm_getcsr();
 
-					Param::Log(params);
+					// FTZ (bit 15) | DAZ (bit 6).
+					_mm_setcsr(static_cast<unsigned int>(prevFPMode) | 0x8040u);
+				#elif defined(__aarch64__)
+					asm volatile("mrs %0, fpcr" : "=r"(prevFPMode));
+
+					// FZ (bit 24): flush both inputs and outputs.
+					const unsigned long long mode = prevFPMode | (1ull << 24);
+					asm volatile("msr fpcr, %0" : : "r"(mode));
+				#else
+					applied.bFlushDenormals = false;
+				#endif
+				}
+
+				// Scheduling priority.
+				if (applied.bHighPriority)
+				{
+				#if _WIN32
+					prevPriority = GetThreadPriority(GetCurrentThread());
+
+					if (!SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_HIGHEST))
+						applied.bHighPriority = false;
+				#else
+					prevPriority = getpriority(PRIO_PROCESS, 0);
 
-					if (ParamsCB)
-						ParamsCB(params);
+					// Lowering niceness requires privileges.
+					if (setpriority(PRIO_PROCESS, 0, -20) != 0)
+						applied.bHighPriority = false;
+				#endif
 				}
 			}
 
-			template <typename FirstT, typename... Args>
-			void GenerateParamStr(std::vector<Param>& _result, std::string _paramNames, const FirstT& _first, const Args&... _args)
+			BenchEnvScope::~BenchEnvScope()
 			{
-				size_t index = _paramNames.find_first_of(',');
+				if (applied.bHighPriority)
+				{
+				#if _WIN32
+					SetThreadPriority(GetCurrentThread(), prevPriority);
+				#else
+					setpriority(PRIO_PROCESS, 0, prevPriority);
+				#endif
+				}
 
-				_result.push_back(Param{ _paramNames.substr(0u, index), Sa::UTH::ToString(_first) });
+				if (applied.bFlushDenormals)
+				{
+				#if defined(__SSE__) || defined(_M_X64) || defined(_M_IX86)
+					_mm_setcsr(static_cast<unsigned int>(prevFPMode));
+				#elif defined(__aarch64__)
+					asm volatile("msr fpcr, %0" : : "r"(prevFPMode));
+				#endif
+				}
 
-				if constexpr (sizeof...(_args) != 0)
-					GenerateParamStr(_result, _paramNames.substr(index + 2), _args...);
+				if (applied.cpu >= 0)
+				{
+				#if _WIN32
+					SetThreadAffinityMask(GetCurrentThread(), prevAffinity);
+				#elif __linux__
+					pthread_setaffinity_np(pthread_self(), sizeof(prevAffinity), &prevAffinity);
+				#endif
+				}
 			}
 
+			const BenchEnv& BenchEnvScope::Applied() const noexcept
+			{
+				return applied;
+			}
 
-			void ComputeResult(bool _pred)
+			std::string FormatDuration(double _ns)
 			{
-				if (!_pred)
-					Sa::UTH::exit = EXIT_FAILURE;
+				static const char* const units[] = { "ns", "us", "ms", "s" };
 
-				if (ResultCB)
-					ResultCB(_pred);
+				unsigned int unit = 0u;
 
-#if SA_UTH_EXIT_ON_FAILURE
-				if (!_pred)
-					::exit(EXIT_FAILURE);
-#endif
-			}
+				while (std::abs(_ns) >= 1000.0 && unit < 3u)
+				{
+					_ns /= 1000.0;
+					++unit;
+				}
 
-			inline bool ShouldComputeTest(bool _pred)
-			{
-				return !_pred || (verbosity & Verbosity::Success);
+				std::ostringstream res;
+				res << std::fixed << std::setprecision(2) << _ns << ' ' << units[unit];
+
+				return res.str();
 			}
 
-			template <typename... Args>
-			unsigned int SizeOfArgs(const Args&...)
+			std::string FormatRate(double _rate, const char* _unit)
 			{
-				return sizeof...(Args);
+				static const char* const prefixes[] = { "", "k", "M", "G", "T" };
+
+				unsigned int prefix = 0u;
+
+				while (_rate >= 1000.0 && prefix < 4u)
+				{
+					_rate /= 1000.0;
+					++prefix;
+				}
+
+				std::ostringstream res;
+				res << std::fixed << std::setprecision(2) << _rate << ' ' << prefixes[prefix] << _unit << "/s";
+
+				return res.str();
 			}
 		}
 
@@ -1297,6 +7667,10 @@ namespace Sa
 		/// Helper macro for file name.
 		#define __SA_UTH_FILE_NAME Sa::UTH::Intl::GetFileNameFromPath(__FILE__)
 
+		/// Helper macros for unique variable name per line.
+		#define __SA_UTH_CONCAT_IMPL(_lhs, _rhs) _lhs##_rhs
+		#define __SA_UTH_CONCAT(_lhs, _rhs) __SA_UTH_CONCAT_IMPL(_lhs, _rhs)
+
 		/// \endcond
 
 
@@ -1317,15 +7691,15 @@ namespace Sa
 			auto&& sLhs = _lhs;\
 			auto&& sRhs = _rhs;\
 			bool bRes = Sa::UTH::Equals(sLhs, sRhs, ##__VA_ARGS__);\
-			Sa::UTH::Intl::Update(bRes);\
+			static constexpr Sa::UTH::TestSite sSite{ __FILE__, __LINE__,\
+				sizeof(#__VA_ARGS__) > 1u ? "Sa::UTH::Equals(" #_lhs ", " #_rhs ", " #__VA_ARGS__ ")" : "Sa::UTH::Equals(" #_lhs ", " #_rhs ")",\
+				#_lhs ", " #_rhs ", " #__VA_ARGS__ };\
+			Sa::UTH::Intl::Update(bRes, sSite);\
 		\
 			if(Sa::UTH::Intl::ShouldComputeTest(bRes))\
 			{\
-				std::string titleStr = std::string("Sa::UTH::Equals(" #_lhs ", " #_rhs) + \
-				(Sa::UTH::Intl::SizeOfArgs(__VA_ARGS__) ? ", " #__VA_ARGS__ ")" : ")");\
-			\
-				Sa::UTH::Intl::ComputeTitle(Sa::UTH::Title{ titleStr, __SA_UTH_FILE_NAME, __LINE__, bRes });\
-				Sa::UTH::Intl::ComputeParam(bRes, #_lhs ", " #_rhs ", " #__VA_ARGS__, sLhs, sRhs, ##__VA_ARGS__);\
+				Sa::UTH::Intl::ComputeTitle(sSite, bRes);\
+				Sa::UTH::Intl::ComputeParam(sSite, bRes, sLhs, sRhs, ##__VA_ARGS__);\
 				Sa::UTH::Intl::ComputeResult(bRes);\
 			}\
 		}
@@ -1341,12 +7715,13 @@ namespace Sa
 		#define SA_UTH_SF(_func, ...)\
 		{\
 			bool bRes = _func(__VA_ARGS__);\
-			Sa::UTH::Intl::Update(bRes);\
+			static constexpr Sa::UTH::TestSite sSite{ __FILE__, __LINE__, #_func "(" #__VA_ARGS__ ")", #__VA_ARGS__ };\
+			Sa::UTH::Intl::Update(bRes, sSite);\
 		\
 			if(Sa::UTH::Intl::ShouldComputeTest(bRes))\
 			{\
-				Sa::UTH::Intl::ComputeTitle(Sa::UTH::Title{ #_func "(" #__VA_ARGS__ ")", __SA_UTH_FILE_NAME, __LINE__, bRes });\
-				Sa::UTH::Intl::ComputeParam(bRes, #__VA_ARGS__, __VA_ARGS__);\
+				Sa::UTH::Intl::ComputeTitle(sSite, bRes);\
+				Sa::UTH::Intl::ComputeParam(sSite, bRes, __VA_ARGS__);\
 				Sa::UTH::Intl::ComputeResult(bRes);\
 			}\
 		}
@@ -1363,12 +7738,13 @@ namespace Sa
 		{\
 			auto result = _func(__VA_ARGS__);\
 			bool bRes = result == _res;\
-			Sa::UTH::Intl::Update(bRes);\
+			static constexpr Sa::UTH::TestSite sSite{ __FILE__, __LINE__, #_func "(" #__VA_ARGS__ ") == " #_res, #__VA_ARGS__ ", " #_func "(), " #_res };\
+			Sa::UTH::Intl::Update(bRes, sSite);\
 		\
 			if(Sa::UTH::Intl::ShouldComputeTest(bRes))\
 			{\
-				Sa::UTH::Intl::ComputeTitle(Sa::UTH::Title{ #_func "(" #__VA_ARGS__ ") == " #_res, __SA_UTH_FILE_NAME, __LINE__, bRes });\
-				Sa::UTH::Intl::ComputeParam(bRes, #__VA_ARGS__ ", " #_func "(), " #_res, __VA_ARGS__, result, _res);\
+				Sa::UTH::Intl::ComputeTitle(sSite, bRes);\
+				Sa::UTH::Intl::ComputeParam(sSite, bRes, __VA_ARGS__, result, _res);\
 				Sa::UTH::Intl::ComputeResult(bRes);\
 			}\
 		}
@@ -1385,12 +7761,13 @@ namespace Sa
 		#define SA_UTH_MF(_caller, _func, ...)\
 		{\
 			bool bRes = (_caller)._func(__VA_ARGS__);\
-			Sa::UTH::Intl::Update(bRes);\
+			static constexpr Sa::UTH::TestSite sSite{ __FILE__, __LINE__, #_caller "." #_func "(" #__VA_ARGS__ ")", #_caller ", " #__VA_ARGS__ };\
+			Sa::UTH::Intl::Update(bRes, sSite);\
 		\
 			if(Sa::UTH::Intl::ShouldComputeTest(bRes))\
 			{\
-				Sa::UTH::Intl::ComputeTitle(Sa::UTH::Title{ #_caller "." #_func "(" #__VA_ARGS__ ")", __SA_UTH_FILE_NAME, __LINE__, bRes });\
-				Sa::UTH::Intl::ComputeParam(bRes, #_caller ", " #__VA_ARGS__, _caller, ##__VA_ARGS__);\
+				Sa::UTH::Intl::ComputeTitle(sSite, bRes);\
+				Sa::UTH::Intl::ComputeParam(sSite, bRes, _caller, ##__VA_ARGS__);\
 				Sa::UTH::Intl::ComputeResult(bRes);\
 			}\
 		}
@@ -1408,12 +7785,13 @@ namespace Sa
 		{\
 			auto result = (_caller)._func(__VA_ARGS__);\
 			bool bRes = result == _res;\
-			Sa::UTH::Intl::Update(bRes);\
+			static constexpr Sa::UTH::TestSite sSite{ __FILE__, __LINE__, #_caller "." #_func "(" #__VA_ARGS__ ") == " #_res, #_caller ", " #__VA_ARGS__ ", " #_caller "." #_func "(), " #_res };\
+			Sa::UTH::Intl::Update(bRes, sSite);\
 		\
 			if(Sa::UTH::Intl::ShouldComputeTest(bRes))\
 			{\
-				Sa::UTH::Intl::ComputeTitle(Sa::UTH::Title{ #_caller "." #_func "(" #__VA_ARGS__ ") == " #_res, __SA_UTH_FILE_NAME, __LINE__, bRes });\
-				Sa::UTH::Intl::ComputeParam(bRes, #_caller ", " #__VA_ARGS__ ", " #_caller "." #_func "(), " #_res, _caller, __VA_ARGS__, result, _res);\
+				Sa::UTH::Intl::ComputeTitle(sSite, bRes);\
+				Sa::UTH::Intl::ComputeParam(sSite, bRes, _caller, __VA_ARGS__, result, _res);\
 				Sa::UTH::Intl::ComputeResult(bRes);\
 			}\
 		}
@@ -1433,12 +7811,13 @@ namespace Sa
 			auto&& sLhs = _lhs;\
 			auto&& sRhs = _rhs;\
 			bool bRes = sLhs _op sRhs;\
-			Sa::UTH::Intl::Update(bRes);\
+			static constexpr Sa::UTH::TestSite sSite{ __FILE__, __LINE__, #_lhs " " #_op " " #_rhs, #_lhs ", " #_rhs };\
+			Sa::UTH::Intl::Update(bRes, sSite);\
 		\
 			if(Sa::UTH::Intl::ShouldComputeTest(bRes))\
 			{\
-				Sa::UTH::Intl::ComputeTitle(Sa::UTH::Title{ #_lhs " " #_op " " #_rhs, __SA_UTH_FILE_NAME, __LINE__, bRes });\
-				Sa::UTH::Intl::ComputeParam(bRes, #_lhs ", " #_rhs, sLhs, sRhs);\
+				Sa::UTH::Intl::ComputeTitle(sSite, bRes);\
+				Sa::UTH::Intl::ComputeParam(sSite, bRes, sLhs, sRhs);\
 				Sa::UTH::Intl::ComputeResult(bRes);\
 			}\
 		}
@@ -1459,12 +7838,13 @@ namespace Sa
 			auto&& sRhs = _rhs;\
 			auto result = sLhs _op sRhs;\
 			bool bRes = result == _res;\
-			Sa::UTH::Intl::Update(bRes);\
+			static constexpr Sa::UTH::TestSite sSite{ __FILE__, __LINE__, #_lhs " " #_op " " #_rhs " == " #_res, #_lhs ", " #_rhs ", " #_lhs " " #_op " " #_rhs ", " #_res };\
+			Sa::UTH::Intl::Update(bRes, sSite);\
 		\
 			if(Sa::UTH::Intl::ShouldComputeTest(bRes))\
 			{\
-				Sa::UTH::Intl::ComputeTitle(Sa::UTH::Title{ #_lhs " " #_op " " #_rhs " == " #_res, __SA_UTH_FILE_NAME, __LINE__, bRes });\
-				Sa::UTH::Intl::ComputeParam(bRes, #_lhs ", " #_rhs ", " #_lhs " " #_op " " #_rhs ", " #_res, sLhs, sRhs, result, _res);\
+				Sa::UTH::Intl::ComputeTitle(sSite, bRes);\
+				Sa::UTH::Intl::ComputeParam(sSite, bRes, sLhs, sRhs, result, _res);\
 				Sa::UTH::Intl::ComputeResult(bRes);\
 			}\
 		}
@@ -1495,6 +7875,102 @@ namespace Sa
 			SA_UTH_GPE()\
 		}
 
+		/**
+		*	\brief Run a group of tests from a single function in an isolated child process under memory and CPU limits.
+		*
+		*	\param[in] _func	The function that own the group of tests.
+		*	\param[in] _limits	GroupLimits applied to the child process.
+		*/
+		#define SA_UTH_GP_LIMITS(_func, _limits) Sa::UTH::Group::Run(#_func, [&]() { _func; }, _limits, __SA_UTH_FILE_NAME, __LINE__);
+
+
+		/**
+		*	\brief Time the current scope as a named zone.
+		*
+		*	Zones are aggregated per group (count, total, max) and output on group exit,
+		*	and exported in the trace when enabled.
+		*
+		*	\param[in] _name	Name of the zone (string literal).
+		*/
+		#define SA_UTH_ZONE(_name) Sa::UTH::Zone __SA_UTH_CONCAT(sZone, __LINE__){ _name };
+
+
+		/**
+		*	\brief Run a \e <b> Benchmark </b> over a set of input sizes.
+		*
+		*	Output time, items/sec and bytes/sec for each size and the fitted complexity.
+		*
+		*	\param[in] _name	Name of the benchmark.
+		*	\param[in] _sizes	Iterable of input sizes.
+		*	\param[in] _body	Callable with (size_t n) or (Sa::UTH::BenchState& state).
+		*
+		*	Additionnal params:
+		*	Complexity expected:	Run a test failing if the fitted complexity is worse.
+		*/
+		#define SA_UTH_BENCH_RANGE(_name, _sizes, _body, ...)\
+		{\
+			Sa::UTH::Bench sBench = Sa::UTH::Bench::Range(#_name, _sizes, _body);\
+			Sa::UTH::Intl::CheckComplexity(sBench, __SA_UTH_FILE_NAME, __LINE__, ##__VA_ARGS__);\
+		}
+
+
+		/**
+		*	\brief Run a \e <b> Unit Test </b> comparing a baseline and a candidate implementation.
+		*
+		*	Runs are interleaved, then the test succeeds if candidate is significantly faster
+		*	(one-sided Mann-Whitney U test, p < benchSettings.compareAlpha).
+		*
+		*	\param[in] _name		Name of the comparison.
+		*	\param[in] _baseline	Baseline body callable with () or (Sa::UTH::BenchState& state).
+		*	\param[in] _candidate	Candidate body callable with () or (Sa::UTH::BenchState& state).
+		*
+		*	Additionnal params:
+		*	double minSpeedup:		Minimum relative speedup required (ex: 0.1 == at least 10% faster).
+		*/
+		#define SA_UTH_BENCH_COMPARE(_name, _baseline, _candidate, ...)\
+		{\
+			Sa::UTH::BenchCompare sCompare = Sa::UTH::BenchCompare::Run(#_name, _baseline, _candidate, ##__VA_ARGS__);\
+			Sa::UTH::Intl::CheckSpeedup(sCompare, __SA_UTH_FILE_NAME, __LINE__);\
+		}
+
+
+		/**
+		*	\brief Run a multi-thread \e <b> Benchmark </b> on 1, 2, 4, ... _maxThreads threads.
+		*
+		*	Output aggregate throughput and parallel efficiency for each thread count.
+		*
+		*	\param[in] _name		Name of the benchmark.
+		*	\param[in] _maxThreads	Maximum number of threads.
+		*	\param[in] _body		Body callable with () or (Sa::UTH::BenchState& state).
+		*
+		*	Additionnal params:
+		*	double minSpeedup:		Run a test failing if the speedup at _maxThreads is lower.
+		*/
+		#define SA_UTH_BENCH_SCALING(_name, _maxThreads, _body, ...)\
+		{\
+			Sa::UTH::BenchScaling sScaling = Sa::UTH::BenchScaling::Run(#_name, _maxThreads, _body, ##__VA_ARGS__);\
+			Sa::UTH::Intl::CheckScaling(sScaling, __SA_UTH_FILE_NAME, __LINE__);\
+		}
+
+
+		/**
+		*	\brief Record per-operation \e <b> Latency </b> in a histogram.
+		*
+		*	Output count, min, mean, max and p50/p90/p99/p99.9 latencies.
+		*
+		*	\param[in] _name	Name of the recording.
+		*	\param[in] _op		Operation callable with (), (size_t index) or (Sa::UTH::BenchState& state).
+		*	\param[in] _count	Number of operations to record.
+		*
+		*	Additionnal params:
+		*	PercentileBound... bounds:	Run a test for each bound (ex: Sa::UTH::P99 < 50us).
+		*/
+		#define SA_UTH_LATENCY(_name, _op, _count, ...)\
+		{\
+			Sa::UTH::Latency sLatency = Sa::UTH::Latency::Run(#_name, _op, _count);\
+			Sa::UTH::Intl::CheckPercentiles(sLatency, __SA_UTH_FILE_NAME, __LINE__, ##__VA_ARGS__);\
+		}
+
 //}
 	}
 }
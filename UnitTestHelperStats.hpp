@@ -0,0 +1,225 @@
+// Copyright (c) 2021 Sapphire's Suite. All Rights Reserved.
+// Repository: https://github.com/SapphireSuite/UnitTestHelper
+
+#pragma once
+
+#ifndef SAPPHIRE_UNIT_TEST_HELPER_STATS_GUARD
+#define SAPPHIRE_UNIT_TEST_HELPER_STATS_GUARD
+
+#include <vector>
+#include <algorithm>
+
+#include <cstdint>
+#include <cstring>
+#include <cerrno>
+#include <atomic>
+
+#include <string>
+#include <filesystem>
+
+#if !_WIN32
+
+#include <signal.h> // Requiered for kill.
+
+#endif
+
+/**
+*	\file UnitTestHelperStats.hpp
+*
+*	\brief Live stats page layout, shared by UnitTestHelper.hpp and the uth-top monitor.
+*
+*	Self-contained: readers include it without the test runtime.
+*/
+
+namespace Sa
+{
+	/// UnitTestHelper global namespace.
+	namespace UTH
+	{
+//{ Stats
+
+		/// Live stats of a worker thread in the stats page (own cache line: no false sharing).
+		struct alignas(64) StatsWorker
+		{
+			/// Thread index + 1 (0 == unused slot).
+			std::atomic<uint32_t> tid{ 0u };
+
+			/// Id of the group path of the last test run by this thread.
+			std::atomic<uint32_t> pathId{ 0u };
+
+			std::atomic<uint64_t> success{ 0u };
+			std::atomic<uint64_t> failure{ 0u };
+		};
+
+		/// Group path entry of the stats page (seqlock: odd seq == being written).
+		struct StatsPath
+		{
+			std::atomic<uint32_t> seq{ 0u };
+			std::atomic<uint32_t> id{ 0u };
+
+			char name[248]{};
+		};
+
+		/**
+		*	\brief Memory-mapped live stats, read by the uth-top companion executable.
+		*
+		*	Every value is updated with relaxed atomics: no I/O or lock in the test process.
+		*	Rates are computed by readers from successive samples.
+		*/
+		struct StatsData
+		{
+			static constexpr uint32_t magicValue = 0x48545553u; // "SUTH"
+			static constexpr uint32_t versionValue = 1u;
+
+			static constexpr uint32_t maxWorkers = 64u;
+			static constexpr uint32_t maxPaths = 32u;
+
+			uint32_t magic = magicValue;
+			uint32_t version = versionValue;
+
+			/// Test process id.
+			int64_t pid = 0;
+
+			/// Process start (nanoseconds since epoch).
+			int64_t startNs = 0;
+
+			/// 0 == running, 1 == exited.
+			std::atomic<uint32_t> state{ 0u };
+
+			/// Current group path id (path of the group thread).
+			std::atomic<uint32_t> pathId{ 0u };
+
+			/// Intl::globalCount.
+			std::atomic<uint64_t> success{ 0u };
+			std::atomic<uint64_t> failure{ 0u };
+
+			/// Group::globalCount.
+			std::atomic<uint64_t> groupSuccess{ 0u };
+			std::atomic<uint64_t> groupFailure{ 0u };
+
+			/// Worker slots (indexed by thread index).
+			StatsWorker workers[maxWorkers];
+
+			/// Ring of the last group paths (indexed by path id).
+			StatsPath paths[maxPaths];
+
+			/**
+			*	\brief Read group path _id (if still in the ring).
+			*
+			*	\return Path name, or "#<id>" if overwritten.
+			*/
+			std::string PathName(uint32_t _id) const
+			{
+				if (_id == 0u)
+					return std::string();
+
+				const StatsPath& entry = paths[_id % maxPaths];
+
+				for (unsigned int attempt = 0u; attempt < 16u; ++attempt)
+				{
+					const uint32_t seq = entry.seq.load(std::memory_order_acquire);
+
+					// Being written.
+					if (seq & 1u)
+						continue;
+
+					if (entry.id.load(std::memory_order_relaxed) != _id)
+						break;
+
+					char name[sizeof(entry.name)];
+					memcpy(name, entry.name, sizeof(name));
+
+					std::atomic_thread_fence(std::memory_order_acquire);
+
+					if (entry.seq.load(std::memory_order_relaxed) == seq)
+						return std::string(name, std::find(name, name + sizeof(name), '\0'));
+				}
+
+				return '#' + std::to_string(_id);
+			}
+		};
+
+		/**
+		*	\brief Stats page files of the default locations (/dev/shm/sa_uth-<pid>, Logs/stats_UTH-<pid>.shm).
+		*	Not supported on Windows.
+		*/
+		class StatsFile
+		{
+		public:
+			/**
+			*	\brief Remove default pages of processes that died without close (crash, kill).
+			*
+			*	\return Number of removed pages.
+			*/
+			static size_t RemoveStale()
+			{
+				std::vector<std::filesystem::path> stale;
+
+				const auto search = [&stale](const char* _dir)
+				{
+					std::error_code error;
+
+					for (std::filesystem::directory_iterator it(_dir, error), end; !error && it != end; it.increment(error))
+					{
+						const int64_t pid = PagePid(it->path().string());
+
+						if (pid > 0 && !IsAlive(pid))
+							stale.push_back(it->path());
+					}
+				};
+
+				search("/dev/shm");
+				search("Logs");
+
+				size_t removed = 0u;
+
+				for (auto it = stale.begin(); it != stale.end(); ++it)
+				{
+					std::error_code error;
+
+					if (std::filesystem::remove(*it, error))
+						++removed;
+				}
+
+				return removed;
+			}
+
+			/**
+			*	\brief Pid of the process owning the page _path, parsed from the default file name.
+			*
+			*	\return 0 if _path is not a default page.
+			*/
+			static int64_t PagePid(const std::string& _path)
+			{
+				const std::string name = std::filesystem::path(_path).filename().string();
+				std::string digits;
+
+				if (name.rfind("sa_uth-", 0) == 0)
+					digits = name.substr(7u);
+				else if (name.rfind("stats_UTH-", 0) == 0 && name.size() > 14u && name.compare(name.size() - 4u, 4u, ".shm") == 0)
+					digits = name.substr(10u, name.size() - 14u);
+
+				if (digits.empty() || digits.size() > 18u || digits.find_first_not_of("0123456789") != std::string::npos)
+					return 0;
+
+				return std::stoll(digits);
+			}
+
+			/// Whether process _pid is still running.
+			static bool IsAlive(int64_t _pid) noexcept
+			{
+			#if _WIN32
+				(void)_pid;
+				return true;
+			#else
+				// EPERM: running under another user.
+				return kill(static_cast<pid_t>(_pid), 0) == 0 || errno != ESRCH;
+			#endif
+			}
+		};
+
+//}
+	}
+}
+
+#endif // GUARD